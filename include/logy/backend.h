@@ -0,0 +1,100 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Shared logger backend.
+ *
+ * @details
+ * The backend is used to serve many logger instances with a single I/O thread. Attached loggers only format
+ * messages and enqueue them, while the backend thread writes queued records to the log files, rotates them
+ * on schedule and passes rotated files to a bounded pool of compression worker threads. Each attached logger
+ * still has its own directory, logging level and log file.
+ */
+
+#pragma once
+#include "logy/common.h"
+#include <stddef.h>
+
+/**
+ * @brief Default log backend compression thread count.
+ */
+#define DEFAULT_LOG_COMPRESSION_THREAD_COUNT 1
+/**
+ * @brief Default logger backend queued record capacity.
+ */
+#define DEFAULT_LOG_BACKEND_QUEUE_CAPACITY 65536
+
+/**
+ * @brief Log backend structure.
+ */
+typedef struct LogBackend_T LogBackend_T;
+/**
+ * @brief Log backend instance.
+ */
+typedef LogBackend_T* LogBackend;
+
+/**
+ * @brief Creates a new log backend instance.
+ *
+ * @details
+ * Starts a new I/O thread and compression worker threads. Pass created backend to
+ * the @ref createLoggerExt() options to attach a new logger instance to it.
+ *
+ * @note You should destroy created log backend instance manually, after all attached loggers.
+ *
+ * @param compressionThreadCount rotated log file compression thread count, or 0 to compress on I/O thread
+ * @param[out] backend pointer to the log backend instance
+ *
+ * @return The @ref LogyResult code and writes log backend instance on success.
+ *
+ * @retval SUCCESS_LOGY_RESULT on success
+ * @retval FAILED_TO_ALLOCATE_LOGY_RESULT if out of memory
+ */
+LogyResult createLogBackend(uint32_t compressionThreadCount, LogBackend* backend);
+
+/**
+ * @brief Creates a new log backend instance with thread placement options.
+ * @details See the @ref createLogBackend() and @ref LogThreadOptions.
+ *
+ * @param compressionThreadCount rotated log file compression thread count, or 0 to compress on I/O thread
+ * @param[in] threadOptions I/O and compression thread placement options or NULL
+ * @param[out] backend pointer to the log backend instance
+ *
+ * @return The @ref LogyResult code and writes log backend instance on success.
+ *
+ * @retval SUCCESS_LOGY_RESULT on success
+ * @retval FAILED_TO_ALLOCATE_LOGY_RESULT if out of memory
+ */
+LogyResult createLogBackendExt(uint32_t compressionThreadCount,
+	const LogThreadOptions* threadOptions, LogBackend* backend);
+
+/**
+ * @brief Destroys log backend instance.
+ * @details Waits for the queued log file compressions to complete.
+ * @param backend log backend instance or NULL
+ */
+void destroyLogBackend(LogBackend backend);
+
+/**
+ * @brief Returns log backend compression thread count. (MT-Safe)
+ * @param backend log backend instance
+ */
+uint32_t getLogBackendCompressionThreadCount(LogBackend backend);
+
+/**
+ * @brief Returns log backend attached logger count. (MT-Safe)
+ * @param backend log backend instance
+ */
+size_t getLogBackendLoggerCount(LogBackend backend);
@@ -0,0 +1,132 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Logging call-site metadata.
+ *
+ * @details
+ * Logging macros place a static constant initialized call-site descriptor per statement, which holds source
+ * file, line, function name, logging level and message format. Descriptor is interned into the global registry
+ * at first use and receives a small stable integer identifier, which can be used to refer to the statement,
+ * for example to disable it at runtime. Source location is added to the log record without formatting it.
+ */
+
+#pragma once
+#include "logy/logger.h"
+#include "logy/deferred.h"
+
+/**
+ * @brief Logging call-site descriptor.
+ * @note Use LOGY_LOG() or similar macros instead of creating it manually.
+ */
+typedef struct LogCallSite
+{
+	const char* filePath;     /**< Source file path string. */
+	const char* functionName; /**< Source function name string. */
+	const char* fmt;          /**< Formatted message string. */
+	const char* fileName;     /**< Source file name string. (Set on registration) */
+	uint32_t line;            /**< Source file line number. */
+	volatile uint32_t id;     /**< Call-site identifier or 0, if not registered yet. */
+	volatile bool isDisabled; /**< Is call-site messages are not logged. */
+	LogLevel level;           /**< Call-site logging level. */
+} LogCallSite;
+
+/**
+ * @brief Registers call-site in the global registry, if not registered yet. (MT-Safe)
+ * @details Identical call-sites (same file, line and format) receive the same identifier.
+ *
+ * @param[in,out] callSite call-site descriptor
+ * @return Call-site identifier, greater than 0. Or 0 if out of memory.
+ */
+uint32_t registerLogCallSite(LogCallSite* callSite);
+
+/**
+ * @brief Returns registered call-site count. (MT-Safe)
+ * @details Call-site identifiers are in the [1, count] range.
+ */
+uint32_t getLogCallSiteCount();
+
+/**
+ * @brief Returns registered call-site descriptor. (MT-Safe)
+ * @param id call-site identifier
+ * @return Call-site descriptor or NULL if identifier is out of range.
+ */
+const LogCallSite* getLogCallSite(uint32_t id);
+
+/**
+ * @brief Enables or disables registered call-site messages. (MT-Safe)
+ *
+ * @param id call-site identifier
+ * @param isEnabled is call-site enabled
+ */
+void setLogCallSiteEnabled(uint32_t id, bool isEnabled);
+
+/**
+ * @brief Logs call-site message to the log. (MT-Safe)
+ *
+ * @param logger logger instance
+ * @param[in,out] callSite call-site descriptor
+ * @param[in] fmt formatted message string (same as call-site format)
+ * @param args message arguments
+ */
+void logCallSiteMessageVA(Logger logger, LogCallSite* callSite, const char* fmt, va_list args);
+
+/**
+ * @brief Logs call-site message to the log. (MT-Safe)
+ *
+ * @param logger logger instance
+ * @param[in,out] callSite call-site descriptor
+ * @param[in] fmt formatted message string (same as call-site format)
+ * @param ... message arguments
+ */
+void logCallSiteMessage(Logger logger, LogCallSite* callSite, const char* fmt, ...);
+
+/***********************************************************************************************************************
+ * @brief Returns logger instance used by the logging macros.
+ */
+#ifndef LOGY_LOGGER_INSTANCE
+#define LOGY_LOGGER_INSTANCE(logger) (logger)
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define LOGY_FUNCTION_NAME __FUNCTION__
+#else
+#define LOGY_FUNCTION_NAME __func__
+#endif
+
+#define LOGY_EXPAND(x) x
+#define LOGY_FIRST_ARG(first, ...) first
+
+/**
+ * @brief Logs message to the log with the call-site metadata. (MT-Safe)
+ * @details Message arguments are not evaluated if level is disabled and there is no deferral scope.
+ *
+ * @param logger logger instance
+ * @param level message logging level, constant
+ * @param ... formatted message string literal and arguments
+ */
+#define LOGY_LOG(logger, level, ...) do {                                                                  \
+	static LogCallSite logyCallSite = { __FILE__, LOGY_FUNCTION_NAME,                                         \
+		LOGY_EXPAND(LOGY_FIRST_ARG(__VA_ARGS__, 0)), NULL, __LINE__, 0, false, level };                       \
+	if ((level) <= getLoggerLevel(LOGY_LOGGER_INSTANCE(logger)) || isLogDeferralActive())                     \
+		logCallSiteMessage(LOGY_LOGGER_INSTANCE(logger), &logyCallSite, __VA_ARGS__);                         \
+} while (0)
+
+#define LOGY_FATAL(logger, ...) LOGY_LOG(logger, FATAL_LOG_LEVEL, __VA_ARGS__) /**< Logs fatal message. */
+#define LOGY_ERROR(logger, ...) LOGY_LOG(logger, ERROR_LOG_LEVEL, __VA_ARGS__) /**< Logs error message. */
+#define LOGY_WARN(logger, ...) LOGY_LOG(logger, WARN_LOG_LEVEL, __VA_ARGS__)   /**< Logs warning message. */
+#define LOGY_INFO(logger, ...) LOGY_LOG(logger, INFO_LOG_LEVEL, __VA_ARGS__)   /**< Logs info message. */
+#define LOGY_DEBUG(logger, ...) LOGY_LOG(logger, DEBUG_LOG_LEVEL, __VA_ARGS__) /**< Logs debug message. */
+#define LOGY_TRACE(logger, ...) LOGY_LOG(logger, TRACE_LOG_LEVEL, __VA_ARGS__) /**< Logs trace message. */
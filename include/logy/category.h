@@ -0,0 +1,112 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Hierarchical logger categories.
+ *
+ * @details
+ * Category is a lightweight named handle derived from the logger, used to control logging level of
+ * a separate application subsystem. Category names are dot separated paths, for example "net.http" is a
+ * child of the "net" category. Category without its own level inherits level of the nearest parent category
+ * or the logger. Effective level is cached in an atomic value, so message enabled check is a single load.
+ */
+
+#pragma once
+#include "logy/logger.h"
+
+/**
+ * @brief Log category structure.
+ */
+typedef struct LogCategory_T LogCategory_T;
+/**
+ * @brief Log category instance.
+ */
+typedef LogCategory_T* LogCategory;
+
+/**
+ * @brief Returns logger category instance, creates a new one if not exists. (MT-Safe)
+ * @note Categories are owned by the logger and destroyed with it.
+ *
+ * @param logger logger instance
+ * @param[in] name dot separated category name string (e.g. "net.http")
+ * @param[out] category pointer to the log category instance
+ *
+ * @return The @ref LogyResult code and writes log category instance on success.
+ *
+ * @retval SUCCESS_LOGY_RESULT on success
+ * @retval FAILED_TO_ALLOCATE_LOGY_RESULT if out of memory
+ */
+LogyResult getLogCategory(Logger logger, const char* name, LogCategory* category);
+
+/**
+ * @brief Returns log category logger instance. (MT-Safe)
+ * @param category log category instance
+ */
+Logger getLogCategoryLogger(LogCategory category);
+
+/**
+ * @brief Returns log category name string. (MT-Safe)
+ * @param category log category instance
+ */
+const char* getLogCategoryName(LogCategory category);
+
+/**
+ * @brief Returns log category effective logging level. (MT-Safe, Lock-Free)
+ * @param category log category instance
+ */
+LogLevel getLogCategoryLevel(LogCategory category);
+
+/**
+ * @brief Sets log category logging level. (MT-Safe)
+ * @details Child categories without their own level inherit the new level.
+ *
+ * @param category log category instance
+ * @param level message logging level
+ */
+void setLogCategoryLevel(LogCategory category, LogLevel level);
+
+/**
+ * @brief Resets log category logging level, to inherit it from the parent. (MT-Safe)
+ * @param category log category instance
+ */
+void resetLogCategoryLevel(LogCategory category);
+
+/**
+ * @brief Returns true if message with specified level will be logged by the category. (MT-Safe, Lock-Free)
+ *
+ * @param category log category instance
+ * @param level message logging level
+ */
+bool isLogCategoryEnabled(LogCategory category, LogLevel level);
+
+/**
+ * @brief Logs category message to the log. (MT-Safe)
+ *
+ * @param category log category instance
+ * @param level message logging level
+ * @param[in] fmt formatted message string
+ * @param args message arguments
+ */
+void logCategoryMessageVA(LogCategory category, LogLevel level, const char* fmt, va_list args);
+
+/**
+ * @brief Logs category message to the log. (MT-Safe)
+ *
+ * @param category log category instance
+ * @param level message logging level
+ * @param[in] fmt formatted message string
+ * @param ... message arguments
+ */
+void logCategoryMessage(LogCategory category, LogLevel level, const char* fmt, ...);
@@ -38,6 +38,41 @@
  */
 typedef uint8_t LogLevel;
 
+/**
+ * @brief Background thread scheduling policies.
+ */
+typedef enum LogThreadPolicy_T
+{
+	DEFAULT_LOG_THREAD_POLICY = 0, /**< Inherited scheduling policy. */
+	BATCH_LOG_THREAD_POLICY = 1,   /**< Non-interactive thread. (Linux SCHED_BATCH, macOS utility QoS) */
+	IDLE_LOG_THREAD_POLICY = 2,    /**< Runs only on otherwise idle CPUs. (Linux SCHED_IDLE, macOS background QoS) */
+	LOG_THREAD_POLICY_COUNT = 3,
+} LogThreadPolicy_T;
+/**
+ * @brief Background thread scheduling policy.
+ */
+typedef uint8_t LogThreadPolicy;
+
+/**
+ * @brief Background thread placement options.
+ *
+ * @details
+ * Applied by each logger background thread (rotation, backend I/O, compression, forwarding) on start.
+ * The io_uring and direct I/O file writer buffers are first touched by the writing thread, which is the backend
+ * thread for the attached loggers, so with the default first-touch policy they are allocated on its NUMA node.
+ * Other logger state, the io_uring rings and the queued records are allocated by the threads creating them,
+ * the placement does not move them.
+ * Rotated file compression processes inherit the placement of the thread starting them.
+ * Options which are not supported on the platform are ignored. Failure to apply the options,
+ * for example when the nice value is not permitted, is reported as a logger warning message.
+ */
+typedef struct LogThreadOptions
+{
+	uint64_t affinityMask;  /**< Allowed CPU bit mask (CPUs 0 - 63) or 0 (inherited). */
+	int32_t niceValue;      /**< Thread nice value (-20 - 19) or 0 (inherited). (Linux only) */
+	LogThreadPolicy policy; /**< Thread scheduling policy. */
+} LogThreadOptions;
+
 /**
  * @brief Logy result codes.
  */
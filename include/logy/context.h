@@ -0,0 +1,112 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Per-thread logging context.
+ *
+ * @details
+ * Thread context is a stack of key-value pairs, for example request and tenant identifiers, which is added to
+ * every message logged from the thread as a " [key=value ...]" tag. Context is rendered to the prefix string
+ * only when it changes, not for each message. Context can be captured and restored on the worker thread,
+ * to keep it for the asynchronous tasks.
+ */
+
+#pragma once
+#include "logy/common.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief Maximal rendered context prefix length.
+ * @details Pairs which do not fit are not rendered, prefix ends with the "..." instead.
+ */
+#define LOG_CONTEXT_PREFIX_LENGTH 255
+
+/**
+ * @brief Captured logging context structure.
+ */
+typedef struct LogContext_T LogContext_T;
+/**
+ * @brief Captured logging context instance.
+ */
+typedef LogContext_T* LogContext;
+
+/**
+ * @brief Pushes key-value pair to the calling thread context.
+ *
+ * @param[in] key context key string
+ * @param[in] value context value string
+ *
+ * @return The @ref LogyResult code.
+ *
+ * @retval SUCCESS_LOGY_RESULT on success
+ * @retval FAILED_TO_ALLOCATE_LOGY_RESULT if out of memory
+ */
+LogyResult pushLogContext(const char* key, const char* value);
+
+/**
+ * @brief Pops the last key-value pair from the calling thread context.
+ * @note Context should not be empty.
+ */
+void popLogContext();
+
+/**
+ * @brief Removes all key-value pairs from the calling thread context and frees its buffers.
+ * @details Popping the last pair keeps the buffers for the next push, they are freed on the thread exit.
+ */
+void clearLogContext();
+
+/**
+ * @brief Returns calling thread context key-value pair count.
+ */
+uint32_t getLogContextSize();
+
+/**
+ * @brief Returns calling thread rendered context prefix string. (e.g. "request=42 tenant=acme")
+ * @details Returned string is valid until the thread context is changed.
+ */
+const char* getLogContextPrefix();
+
+/**
+ * @brief Captures calling thread context to transfer it to another thread.
+ * @note You should destroy captured context instance manually.
+ *
+ * @param[out] context pointer to the captured context instance
+ *
+ * @return The @ref LogyResult code and writes context instance on success.
+ *
+ * @retval SUCCESS_LOGY_RESULT on success
+ * @retval FAILED_TO_ALLOCATE_LOGY_RESULT if out of memory
+ */
+LogyResult captureLogContext(LogContext* context);
+
+/**
+ * @brief Destroys captured logging context instance.
+ * @param context captured context instance or NULL
+ */
+void destroyLogContext(LogContext context);
+
+/**
+ * @brief Replaces calling thread context with the captured one.
+ * @details Captured context can be restored on many threads.
+ *
+ * @param context captured context instance or NULL (clears context)
+ *
+ * @return The @ref LogyResult code.
+ *
+ * @retval SUCCESS_LOGY_RESULT on success
+ * @retval FAILED_TO_ALLOCATE_LOGY_RESULT if out of memory
+ */
+LogyResult restoreLogContext(LogContext context);
@@ -0,0 +1,71 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Deferred (tail-based) message logging.
+ *
+ * @details
+ * Deferral scope captures calling thread messages which are below the logger level, for example DEBUG messages
+ * of a single request, into a bounded buffer. Messages are not formatted on capture, only copies of the format
+ * string, format arguments and argument strings are stored, so they can be freed right after the call.
+ * If the scope ends successfully the buffer is discarded. If an ERROR
+ * message is logged or the scope is marked failed, buffered messages are written to the log in order, with
+ * their original time, and the following scope messages are written directly until the scope end.
+ */
+
+#pragma once
+#include "logy/logger.h"
+
+/**
+ * @brief Default deferral scope buffer size in bytes.
+ */
+#define DEFAULT_LOG_DEFERRAL_BUFFER_SIZE 65536
+
+/**
+ * @brief Begins a new deferral scope on the calling thread.
+ * @details Scopes can be nested, each scope should be ended on the same thread.
+ * 
+ * @param logger logger instance
+ * @param level deferred message logging level, inclusive
+ * @param bufferSize message buffer size in bytes
+ *
+ * @return The @ref LogyResult code.
+ *
+ * @retval SUCCESS_LOGY_RESULT on success
+ * @retval FAILED_TO_ALLOCATE_LOGY_RESULT if out of memory
+ */
+LogyResult beginLogDeferral(Logger logger, LogLevel level, size_t bufferSize);
+
+/**
+ * @brief Ends the last calling thread deferral scope.
+ * @details Discards buffered messages if scope was not failed.
+ */
+void endLogDeferral();
+
+/**
+ * @brief Marks the last calling thread deferral scope as failed.
+ * @details Writes buffered messages of the scope, and of the enclosing scopes with the same logger.
+ */
+void failLogDeferral();
+
+/**
+ * @brief Returns true if calling thread has a deferral scope.
+ */
+bool isLogDeferralActive();
+
+/**
+ * @brief Returns true if the last calling thread deferral scope is failed.
+ */
+bool isLogDeferralFailed();
@@ -0,0 +1,57 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Local agent log forwarding.
+ *
+ * @details
+ * Logger can send written records to a local log agent over a Unix domain socket, instead of the agent tailing
+ * the log files. Records are queued and sent in batches by the forwarding thread, so message writers are never
+ * blocked by the socket. While agent is down or slow, records are appended to the bounded spool file in the logs
+ * directory, and are replayed in order after reconnection. Spool file is kept between application runs.
+ * Forwarding is enabled by setting the socket path in the @ref LoggerOptions.
+ *
+ * Stream socket records are newline terminated, or octet-counted (RFC 6587) with the syslog framing.
+ * Datagram socket sends one record per datagram. Syslog framing formats records as RFC 5424 messages.
+ *
+ * @note Forwarding is supported only on Linux and macOS, it is ignored on other platforms.
+ */
+
+#pragma once
+#include "logy/logger.h"
+
+/**
+ * @brief Log forwarding spool file name.
+ */
+#define LOG_FORWARD_SPOOL_FILE_NAME "forward.spool"
+
+/**
+ * @brief Returns true if logger forwards records to the local agent socket. (MT-Safe)
+ * @param logger logger instance
+ */
+bool isLoggerForwarding(Logger logger);
+
+/**
+ * @brief Returns true if logger is connected to the local agent socket. (MT-Safe)
+ * @param logger logger instance
+ */
+bool isLoggerForwardConnected(Logger logger);
+
+/**
+ * @brief Returns dropped forwarded record count. (MT-Safe)
+ * @details Records are dropped if forwarding queue or spool file is full.
+ * @param logger logger instance
+ */
+uint64_t getLoggerForwardDropCount(Logger logger);
@@ -25,6 +25,7 @@
 
 #pragma once
 #include "logy/common.h"
+#include "logy/backend.h"
 
 #include <stdarg.h>
 #include <stdbool.h>
@@ -43,6 +44,170 @@ typedef struct Logger_T Logger_T;
  */
 typedef Logger_T* Logger;
 
+/**
+ * @brief Log file writer types.
+ */
+typedef enum LogWriterType_T
+{
+	STDIO_LOG_WRITER_TYPE = 0,    /**< Buffered C stdio file stream. */
+	VECTORED_LOG_WRITER_TYPE = 1, /**< Batched vectored (writev) system calls. Falls back to stdio if unsupported. */
+	IO_URING_LOG_WRITER_TYPE = 2, /**< Linux io_uring with registered buffers. Falls back to vectored if unsupported. */
+	DIRECT_LOG_WRITER_TYPE = 3,   /**< Linux O_DIRECT aligned block writes. Requires backend, falls back to vectored. */
+	LOG_WRITER_TYPE_COUNT = 4,
+} LogWriterType_T;
+/**
+ * @brief Log file writer type.
+ */
+typedef uint8_t LogWriterType;
+
+/**
+ * @brief Log metrics snapshot formats.
+ */
+typedef enum LogMetricsFormat_T
+{
+	PROMETHEUS_LOG_METRICS_FORMAT = 0, /**< Prometheus text exposition format. (node_exporter textfile collector) */
+	JSON_LOG_METRICS_FORMAT = 1,       /**< JSON object. */
+	LOG_METRICS_FORMAT_COUNT = 2,
+} LogMetricsFormat_T;
+/**
+ * @brief Log metrics snapshot format.
+ */
+typedef uint8_t LogMetricsFormat;
+
+/**
+ * @brief Log forwarding socket types.
+ */
+typedef enum LogForwardType_T
+{
+	STREAM_LOG_FORWARD_TYPE = 0,   /**< Unix domain stream socket. */
+	DATAGRAM_LOG_FORWARD_TYPE = 1, /**< Unix domain datagram socket. */
+	LOG_FORWARD_TYPE_COUNT = 2,
+} LogForwardType_T;
+/**
+ * @brief Log forwarding socket type.
+ */
+typedef uint8_t LogForwardType;
+
+/**
+ * @brief Logger creation options.
+ * @details Use @ref getDefaultLoggerOptions() to get default option values.
+ */
+typedef struct LoggerOptions
+{
+	/**
+	 * @brief Shared log backend instance or NULL.
+	 * @details Logger writes messages using the backend I/O thread instead of the calling thread.
+	 */
+	LogBackend backend;
+	/**
+	 * @brief Backend queued record capacity or 0 (unlimited).
+	 * @details New records are dropped while the queue is full, see the @ref getLoggerBackendDropCount().
+	 */
+	uint32_t backendQueueCapacity;
+	/**
+	 * @brief Log file writer type.
+	 * @details Vectored and io_uring writers submit all records queued on the backend with a single call.
+	 * 
+	 * Direct writer keeps written logs out of the page cache, so heavy logging does not evict other
+	 * application pages. It writes 4 KiB aligned blocks and preallocates file space with large extents.
+	 * The last partial block is padded with zeros until the file is rotated or closed, then file is truncated.
+	 * It is used only with a backend, which batches queued records, and falls back to the vectored writer
+	 * without a backend or if file system does not support direct I/O.
+	 */
+	LogWriterType writerType;
+	/**
+	 * @brief Recent log record ring capacity or 0.
+	 * @details Logger keeps the last formatted records in memory, see the @ref createLogSnapshot().
+	 */
+	uint32_t ringCapacity;
+	/**
+	 * @brief Recent log record ring memory limit in bytes or 0 (unlimited).
+	 */
+	size_t ringMemoryLimit;
+	/**
+	 * @brief Per-thread timing span buffer capacity or 0 (disabled).
+	 * @details Logger writes timing spans to the trace file, which is rotated with the log file, see the span.h
+	 * Buffer of the exited thread is released after its remaining spans are written to the trace file.
+	 */
+	uint32_t spanBufferCapacity;
+	/**
+	 * @brief Metrics snapshot interval in seconds or 0 (disabled).
+	 * @details Logger counts written messages and writes metrics snapshot file, see the @ref logMetric().
+	 */
+	double metricsInterval;
+	/**
+	 * @brief Metrics snapshot file format.
+	 */
+	LogMetricsFormat metricsFormat;
+	/**
+	 * @brief Local agent Unix domain socket path or NULL (disabled).
+	 * @details Logger sends written records to the agent socket, see the @ref forward.h
+	 */
+	const char* forwardSocketPath;
+	/**
+	 * @brief Local agent socket type.
+	 */
+	LogForwardType forwardType;
+	/**
+	 * @brief Format forwarded records as syslog RFC 5424 messages.
+	 */
+	bool forwardSyslog;
+	/**
+	 * @brief Forwarding spool file size limit in bytes or 0 (records are dropped while agent is down).
+	 */
+	size_t forwardSpoolLimit;
+	/**
+	 * @brief Load shedding write latency threshold in seconds or 0 (disabled).
+	 * @details Logger limits effective level while writes are slower, see the @ref shedding.h
+	 */
+	double shedLatency;
+	/**
+	 * @brief Load shedding backend queued record threshold or 0 (disabled).
+	 */
+	uint32_t shedBacklog;
+	/**
+	 * @brief Load shedding recovery time in seconds, before each level limit relaxation.
+	 */
+	double shedRecoveryTime;
+	/**
+	 * @brief Minimal load shedding logging level limit. (Messages <= level are never shed)
+	 */
+	LogLevel shedMinLevel;
+	/**
+	 * @brief Logger own background thread placement options.
+	 * @details Used by the rotation and forwarding threads. Backend has its own, see the @ref createLogBackendExt().
+	 */
+	LogThreadOptions threadOptions;
+} LoggerOptions;
+
+/**
+ * @brief Returns default logger creation options.
+ */
+inline static LoggerOptions getDefaultLoggerOptions()
+{
+	LoggerOptions options;
+	options.backend = NULL;
+	options.backendQueueCapacity = DEFAULT_LOG_BACKEND_QUEUE_CAPACITY;
+	options.writerType = STDIO_LOG_WRITER_TYPE;
+	options.ringCapacity = 0;
+	options.ringMemoryLimit = 0;
+	options.spanBufferCapacity = 0;
+	options.metricsInterval = 0.0;
+	options.metricsFormat = PROMETHEUS_LOG_METRICS_FORMAT;
+	options.forwardSocketPath = NULL;
+	options.forwardType = STREAM_LOG_FORWARD_TYPE;
+	options.forwardSyslog = false;
+	options.forwardSpoolLimit = 64 * 1024 * 1024;
+	options.shedLatency = 0.0;
+	options.shedBacklog = 0;
+	options.shedRecoveryTime = 1.0;
+	options.shedMinLevel = WARN_LOG_LEVEL;
+	options.threadOptions.affinityMask = 0;
+	options.threadOptions.niceValue = 0;
+	options.threadOptions.policy = DEFAULT_LOG_THREAD_POLICY;
+	return options;
+}
+
 /**
  * @brief Creates a new logger instance.
  * 
@@ -69,6 +234,29 @@ typedef Logger_T* Logger;
 LogyResult createLogger(const char* directoryPath, LogLevel level,
 	bool logToStdout, double rotationTime, bool isAppDataDirectory, Logger* logger);
 
+/**
+ * @brief Creates a new logger instance with the specified options.
+ * @details See the @ref createLogger().
+ * @note You should destroy created logger instance manually.
+ *
+ * @param[in] directoryPath logs directory path string
+ * @param level logging level, inclusive
+ * @param logToStdout duplicate messages to the stdout
+ * @param rotationTime log rotation delay time or 0 (in seconds)
+ * @param isAppDataDirectory write to app data directory
+ * @param[in] options logger creation options or NULL
+ * @param[out] logger pointer to the logger instance
+ * 
+ * @return The @ref LogyResult code and writes logger instance on success.
+ * 
+ * @retval SUCCESS_LOGY_RESULT on success
+ * @retval FAILED_TO_ALLOCATE_LOGY_RESULT if out of memory
+ * @retval FAILED_TO_GET_DIRECTORY_LOGY_RESULT if failed to get data directory path
+ * @retval FAILED_TO_OPEN_FILE_LOGY_RESULT if failed to open file
+ */
+LogyResult createLoggerExt(const char* directoryPath, LogLevel level, bool logToStdout,
+	double rotationTime, bool isAppDataDirectory, const LoggerOptions* options, Logger* logger);
+
 /**
  * @brief Destroys logger instance.
  * @param logger logger instance or NULL
@@ -76,6 +264,32 @@ LogyResult createLogger(const char* directoryPath, LogLevel level,
 void destroyLogger(Logger logger);
 
 /***********************************************************************************************************************
+ * @brief Returns logger shared backend instance or NULL. (MT-Safe)
+ * @param logger logger instance
+ */
+LogBackend getLoggerBackend(Logger logger);
+/**
+ * @brief Returns logger record count dropped because the backend queue was full. (MT-Safe)
+ * @param logger logger instance
+ */
+uint64_t getLoggerBackendDropCount(Logger logger);
+/**
+ * @brief Returns logger log file write count, that failed to write all data. (MT-Safe)
+ * @details Interrupted writes are retried, other failures (e.g. full disk) are counted here.
+ * @param logger logger instance
+ */
+uint64_t getLoggerWriteFailCount(Logger logger);
+
+/**
+ * @brief Returns logger file writer type. (MT-Safe)
+ * @details
+ * Can differ from the requested one, if it's not supported by the system. Direct writer requested
+ * without a backend is replaced with the vectored writer, see the @ref LoggerOptions::writerType.
+ * @param logger logger instance
+ */
+LogWriterType getLoggerWriterType(Logger logger);
+
+/**
  * @brief Returns logger directory path string. (MT-Safe)
  * @param logger logger instance
  */
@@ -100,6 +314,7 @@ double getLoggerRotationTime(Logger logger);
 
 /**
  * @brief Returns current logger logging level. (MT-Safe)
+ * @details Returns configured level, see the @ref getLoggerEffectiveLevel() for the load shedding limit.
  * @param logger logger instance
  */
 LogLevel getLoggerLevel(Logger logger);
@@ -146,4 +361,11 @@ void logMessageVA(Logger logger, LogLevel level, const char* fmt, va_list args);
  * @param[in] fmt formatted message string
  * @param ... message arguments
  */
-void logMessage(Logger logger, LogLevel level, const char* fmt, ...);
\ No newline at end of file
+void logMessage(Logger logger, LogLevel level, const char* fmt, ...);
+
+/**
+ * @brief Writes all queued logger messages to the log file. (MT-Safe)
+ * @details Blocks until the shared backend writes messages logged before this call.
+ * @param logger logger instance
+ */
+void flushLogger(Logger logger);
\ No newline at end of file
@@ -0,0 +1,94 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Log-derived metrics aggregation.
+ *
+ * @details
+ * Logger can count written messages per level and per call-site (see the @ref callsite.h), and record numeric
+ * values into log-scale histograms. Counters are per-thread and lock-free, they are aggregated by the logger
+ * background thread, which periodically writes a snapshot file to the logs directory, so collectors do not
+ * need to parse log files. Snapshot contains total counts and counts over the rolling window of the last
+ * @ref LOG_METRICS_WINDOW_COUNT intervals. Metrics are enabled by setting the interval in the @ref LoggerOptions.
+ *
+ * Counters of the exited thread are merged into the logger totals and their memory is released on the next
+ * snapshot, so short-lived threads do not accumulate memory until the logger is destroyed.
+ */
+
+#pragma once
+#include "logy/logger.h"
+
+/**
+ * @brief Prometheus text format metrics snapshot file name.
+ */
+#define PROMETHEUS_LOG_METRICS_FILE_NAME "metrics.prom"
+/**
+ * @brief JSON format metrics snapshot file name.
+ */
+#define JSON_LOG_METRICS_FILE_NAME "metrics.json"
+
+/**
+ * @brief Metrics rolling window interval count.
+ */
+#define LOG_METRICS_WINDOW_COUNT 12
+/**
+ * @brief Metric histogram bucket count.
+ * @details Bucket upper bound is a power of two, from 2^-31 to 2^31, the last bucket is unbounded.
+ */
+#define LOG_METRIC_BUCKET_COUNT 64
+/**
+ * @brief Maximal registered metric count.
+ */
+#define MAX_LOG_METRIC_COUNT 256
+
+/**
+ * @brief Registers metric name in the global registry, if not registered yet. (MT-Safe)
+ * @details Register metrics once, at the initialization, then use returned identifier to record values.
+ *
+ * @param[in] name metric name string
+ * @return Metric identifier, greater than 0. Or 0 if out of memory or metric count limit is reached.
+ */
+uint32_t registerLogMetric(const char* name);
+
+/**
+ * @brief Returns registered metric name string or NULL. (MT-Safe)
+ * @param metricId metric identifier
+ */
+const char* getLogMetricName(uint32_t metricId);
+
+/**
+ * @brief Returns true if logger aggregates metrics. (MT-Safe)
+ * @param logger logger instance
+ */
+bool isLoggerMetricsEnabled(Logger logger);
+
+/**
+ * @brief Records metric value to the calling thread histogram. (MT-Safe, Lock-Free)
+ * @details Locks the metrics mutex only on the first thread record.
+ *
+ * @param logger logger instance
+ * @param metricId metric identifier
+ * @param value metric value (e.g. latency in seconds)
+ */
+void logMetric(Logger logger, uint32_t metricId, double value);
+
+/**
+ * @brief Returns total logger written message count of the specified level. (MT-Safe)
+ * @details Returns 0 if metrics are disabled.
+ *
+ * @param logger logger instance
+ * @param level message logging level
+ */
+uint64_t getLoggerMessageCount(Logger logger, LogLevel level);
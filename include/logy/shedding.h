@@ -0,0 +1,61 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Adaptive load shedding.
+ *
+ * @details
+ * When log writes stall (e.g. slow disk) or backend queue grows, logger can temporarily limit the effective
+ * logging level, dropping the most verbose enabled level step by step (e.g. DEBUG, then INFO), so logging does not
+ * turn into an application outage. Limit is removed step by step after write latency and backlog stay below the
+ * half of the thresholds for the recovery time. Each transition and suppressed message count is written to the
+ * log with the warning level. Shedding is enabled by setting the thresholds in the @ref LoggerOptions.
+ *
+ * Configured logger and category levels are not changed, suppressed messages are only counted.
+ */
+
+#pragma once
+#include "logy/logger.h"
+
+/**
+ * @brief Load shedding statistics.
+ */
+typedef struct LogShedStats
+{
+	double writeLatency;      /**< Maximal write latency over the last update in seconds. */
+	uint64_t suppressedCount; /**< Total suppressed message count. */
+	uint32_t backlog;         /**< Backend queued record count on the last update. */
+	uint32_t transitionCount; /**< Total level limit transition count. */
+	LogLevel level;           /**< Current logging level limit, or ALL_LOG_LEVEL if not shedding. */
+} LogShedStats;
+
+/**
+ * @brief Returns true if logger currently sheds messages. (MT-Safe)
+ * @param logger logger instance
+ */
+bool isLoggerShedding(Logger logger);
+
+/**
+ * @brief Returns logger effective logging level, limited by the load shedding. (MT-Safe)
+ * @param logger logger instance
+ */
+LogLevel getLoggerEffectiveLevel(Logger logger);
+
+/**
+ * @brief Returns logger load shedding statistics. (MT-Safe)
+ * @details Returns zero statistics if shedding is disabled.
+ * @param logger logger instance
+ */
+LogShedStats getLoggerShedStats(Logger logger);
@@ -0,0 +1,116 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Recent log records snapshot.
+ *
+ * @details
+ * Logger can keep the last formatted records in a fixed size in-memory ring, see the @ref LoggerOptions.
+ * Snapshot is used to inspect them from a running application, for example from an admin endpoint, without
+ * re-reading the log file. Snapshot creation does not lock the logger mutex, so it never blocks message writers.
+ * Records are shared with the log file output and are not formatted twice.
+ */
+
+#pragma once
+#include "logy/logger.h"
+
+/**
+ * @brief Log record snapshot filter.
+ * @details Use @ref getDefaultLogFilter() to get default filter values.
+ */
+typedef struct LogFilter
+{
+	double minTime;         /**< Minimal record time in seconds since the Epoch, inclusive. */
+	double maxTime;         /**< Maximal record time in seconds since the Epoch, inclusive. */
+	const char* threadName; /**< Record thread name or NULL. */
+	LogLevel level;         /**< Record logging level, inclusive. */
+} LogFilter;
+
+/**
+ * @brief Returns default log record snapshot filter. (Accepts all records)
+ */
+inline static LogFilter getDefaultLogFilter()
+{
+	LogFilter filter;
+	filter.minTime = 0.0;
+	filter.maxTime = 1.0e300;
+	filter.threadName = NULL;
+	filter.level = ALL_LOG_LEVEL;
+	return filter;
+}
+
+/**
+ * @brief Log record snapshot entry.
+ */
+typedef struct LogEntry
+{
+	const char* record;     /**< Formatted log record string, as written to the file. */
+	const char* message;    /**< Record message part string, without the header. */
+	const char* threadName; /**< Record thread name string. */
+	double time;            /**< Record time in seconds since the Epoch. */
+	uint32_t length;        /**< Formatted record string length, including new line. */
+	uint32_t callSiteId;    /**< Record call-site identifier or 0. */
+	LogLevel level;         /**< Record logging level. */
+} LogEntry;
+
+/**
+ * @brief Log record snapshot structure.
+ */
+typedef struct LogSnapshot_T LogSnapshot_T;
+/**
+ * @brief Log record snapshot instance.
+ */
+typedef LogSnapshot_T* LogSnapshot;
+
+/**
+ * @brief Creates a new snapshot of the recent logger records. (MT-Safe)
+ *
+ * @details
+ * Returns records from the logger in-memory ring matching the filter, ordered from the oldest to the newest.
+ * Snapshot is empty if ring is disabled. Snapshot keeps references to the records, so they stay valid until
+ * the snapshot is destroyed, even if logger evicts them from the ring.
+ *
+ * @note You should destroy created snapshot instance manually.
+ *
+ * @param logger logger instance
+ * @param[in] filter log record filter or NULL
+ * @param[out] snapshot pointer to the snapshot instance
+ *
+ * @return The @ref LogyResult code and writes snapshot instance on success.
+ *
+ * @retval SUCCESS_LOGY_RESULT on success
+ * @retval FAILED_TO_ALLOCATE_LOGY_RESULT if out of memory
+ */
+LogyResult createLogSnapshot(Logger logger, const LogFilter* filter, LogSnapshot* snapshot);
+
+/**
+ * @brief Destroys log record snapshot instance.
+ * @param snapshot snapshot instance or NULL
+ */
+void destroyLogSnapshot(LogSnapshot snapshot);
+
+/**
+ * @brief Returns log record snapshot entry count.
+ * @param snapshot snapshot instance
+ */
+size_t getLogSnapshotSize(LogSnapshot snapshot);
+
+/**
+ * @brief Returns log record snapshot entry.
+ *
+ * @param snapshot snapshot instance
+ * @param index entry index
+ */
+LogEntry getLogSnapshotEntry(LogSnapshot snapshot, size_t index);
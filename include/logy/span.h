@@ -0,0 +1,90 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Scoped timing spans.
+ *
+ * @details
+ * Spans measure hot-path timings without formatting messages or locking the logger mutex. Each thread records
+ * begin and end timestamps with the span name identifier into its own buffer, which is drained by the logger
+ * background thread. Spans are written to the "trace.json" file in the logs directory, using Chrome Trace Event
+ * JSON format, it can be opened with the chrome://tracing or Perfetto UI. Tracing is enabled by setting the
+ * span buffer capacity in the @ref LoggerOptions.
+ *
+ * Trace file follows the log file: without rotation it is recreated on each logger start, like the "log.txt".
+ * With the log rotation it is named "trace_<date>.json" and rotated together with the log file,
+ * the previous trace file is closed and compressed the same way as the rotated log files.
+ */
+
+#pragma once
+#include "logy/logger.h"
+
+/**
+ * @brief Trace file name, if log rotation is disabled.
+ */
+#define LOG_TRACE_FILE_NAME "trace.json"
+
+/**
+ * @brief Timing span in progress.
+ * @details Use @ref beginLogSpan() and @ref endLogSpan() functions.
+ */
+typedef struct LogSpan
+{
+	uint64_t beginTime; /**< Span begin clock ticks. */
+	uint32_t nameId;    /**< Span name identifier or 0, if not traced. */
+} LogSpan;
+
+/**
+ * @brief Registers span name in the global registry, if not registered yet. (MT-Safe)
+ * @details Register names once, at the initialization, then use returned identifier for spans.
+ *
+ * @param[in] name span name string
+ * @return Span name identifier, greater than 0. Or 0 if out of memory.
+ */
+uint32_t registerLogSpanName(const char* name);
+
+/**
+ * @brief Returns registered span name string or NULL. (MT-Safe)
+ * @param nameId span name identifier
+ */
+const char* getLogSpanName(uint32_t nameId);
+
+/**
+ * @brief Returns true if logger writes timing spans to the trace file. (MT-Safe)
+ * @param logger logger instance
+ */
+bool isLoggerTracing(Logger logger);
+
+/**
+ * @brief Begins a new timing span. (MT-Safe, Lock-Free)
+ *
+ * @param logger logger instance
+ * @param nameId span name identifier
+ *
+ * @return Span value, which should be passed to the @ref endLogSpan() on the same thread.
+ */
+LogSpan beginLogSpan(Logger logger, uint32_t nameId);
+
+/**
+ * @brief Ends timing span and records it to the calling thread buffer. (MT-Safe)
+ * 
+ * @details
+ * Locks the trace mutex only on the first thread span. Span is dropped if the thread buffer is full,
+ * dropped span count is written to the trace as a counter.
+ *
+ * @param logger logger instance
+ * @param span span value returned by the @ref beginLogSpan()
+ */
+void endLogSpan(Logger logger, LogSpan span);
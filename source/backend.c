@@ -0,0 +1,550 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_BACKEND_WAIT_TIME 1.0
+
+typedef struct CompressionJob
+{
+	struct CompressionJob* next;
+	char* filePath;
+} CompressionJob;
+
+struct LogBackend_T
+{
+	Logger* loggers;
+	size_t loggerCount;
+	size_t loggerCapacity;
+	Mutex mutex;
+	Mutex wakeMutex;
+	Cond wakeCond;
+	Cond detachCond;
+	Thread ioThread;
+	Mutex compressionMutex;
+	Cond compressionCond;
+	Thread* compressionThreads;
+	CompressionJob* jobHead;
+	CompressionJob* jobTail;
+	LogThreadOptions threadOptions;
+	uint32_t compressionThreadCount;
+	volatile uint32_t threadFailCount;
+	uint32_t reportedFailCount;
+	uint32_t detachCount;
+	volatile bool hasWork;
+	volatile bool isRunning;
+	volatile bool isCompressing;
+};
+
+//**********************************************************************************************************************
+static void enqueueCompression(LogBackend backend, char* filePath)
+{
+	assert(backend);
+	assert(filePath);
+
+	if (backend->compressionThreadCount == 0)
+	{
+		compressLogFile(NULL, filePath);
+		free(filePath);
+		return;
+	}
+
+	CompressionJob* job = malloc(sizeof(CompressionJob));
+	if (!job)
+	{
+		free(filePath);
+		return;
+	}
+
+	job->next = NULL;
+	job->filePath = filePath;
+
+	Mutex mutex = backend->compressionMutex;
+	lockMutex(mutex);
+	if (backend->jobTail)
+		backend->jobTail->next = job;
+	else
+		backend->jobHead = job;
+	backend->jobTail = job;
+	signalCond(backend->compressionCond);
+	unlockMutex(mutex);
+}
+static void writeQueuedRecords(Logger logger)
+{
+	assert(logger);
+
+	Mutex mutex = logger->mutex;
+	lockMutex(mutex);
+	LogRecord* records = logger->recordHead;
+	logger->recordHead = logger->recordTail = NULL;
+	logyAtomicStore32(&logger->recordCount, 0);
+	unlockMutex(mutex);
+
+	// Note: Attached logger file writes are serialized by the logger backend mutex.
+	if (records && logger->writer)
+	{
+		LogShedder* shedder = logger->shedder;
+		double writeBeginTime = shedder ? beginLogShedWrite(shedder) : 0.0;
+		uint32_t failCount = writeLogRecords(logger->writer, records);
+		if (failCount > 0)
+			logyAtomicFetchAdd64(&logger->writeFailCount, failCount);
+		if (shedder)
+			endLogShedWrite(shedder, writeBeginTime);
+	}
+}
+
+//**********************************************************************************************************************
+static double updateBackendLogger(LogBackend backend, Logger logger, double currentTime, double nextTime)
+{
+	assert(backend);
+	assert(logger);
+
+	if (logger->forwarder && takeLogForwarderThreadFailure(logger->forwarder))
+		logMessage(logger, WARN_LOG_LEVEL, "Failed to apply forwarder thread options.");
+
+	writeQueuedRecords(logger);
+	if (logger->tracer)
+		flushLogTracer(logger->tracer);
+
+	if (logger->metrics)
+	{
+		double metricsTime = updateLogMetrics(logger->metrics, currentTime);
+		if (metricsTime < nextTime)
+			nextTime = metricsTime;
+	}
+	if (logger->shedder)
+	{
+		double shedTime = updateLogShedding(logger, currentTime);
+		if (shedTime < nextTime)
+			nextTime = shedTime;
+	}
+
+	double rotationTime = logger->rotationTime;
+	if (rotationTime <= 0.0)
+		return nextTime;
+
+	if (currentTime >= logger->rotationDelay)
+	{
+		Mutex loggerMutex = logger->mutex;
+		bool isClosed = true;
+		lockMutex(loggerMutex);
+		char* oldFilePath = rotateLogFile(logger, &isClosed);
+		logger->rotationDelay = currentTime + rotationTime;
+		unlockMutex(loggerMutex);
+
+		if (oldFilePath)
+			enqueueCompression(backend, oldFilePath);
+		else
+			logMessage(logger, ERROR_LOG_LEVEL, "Failed to open a new log file.");
+		if (!isClosed)
+			logMessage(logger, WARN_LOG_LEVEL, "Failed to truncate a rotated log file.");
+
+		char* oldTracePath = NULL;
+		if (logger->tracer && !rotateLogTracer(logger->tracer, logger->directoryPath, &oldTracePath))
+			logMessage(logger, ERROR_LOG_LEVEL, "Failed to open a new trace file.");
+		if (oldTracePath)
+			enqueueCompression(backend, oldTracePath);
+	}
+
+	if (logger->rotationDelay < nextTime)
+	nextTime = logger->rotationDelay;
+	return nextTime;
+}
+static void onBackendUpdate(void* argument)
+{
+	assert(argument);
+	setThreadName("LOG");
+
+	LogBackend backend = (LogBackend)argument;
+	if (!applyLogThreadOptions(&backend->threadOptions))
+		logyAtomicFetchAdd32(&backend->threadFailCount, 1);
+
+	Mutex mutex = backend->mutex;
+	Mutex wakeMutex = backend->wakeMutex;
+	Cond wakeCond = backend->wakeCond;
+
+	Logger* snapshot = NULL;
+	size_t snapshotCapacity = 0;
+
+	while (true)
+	{
+		lockMutex(mutex);
+		double currentTime = getCurrentClock();
+		double nextTime = currentTime + MAX_BACKEND_WAIT_TIME;
+		size_t loggerCount = backend->loggerCount;
+
+		// Note: Only the logger array snapshot is taken under the backend mutex, so one slow logger
+		//       file does not block attaching, detaching and flushing of the other loggers.
+		if (loggerCount > snapshotCapacity)
+		{
+			Logger* newSnapshot = realloc(snapshot, backend->loggerCapacity * sizeof(Logger));
+			if (newSnapshot)
+			{
+				snapshot = newSnapshot;
+				snapshotCapacity = backend->loggerCapacity;
+			}
+			else
+			{
+				loggerCount = snapshotCapacity;
+			}
+		}
+
+		for (size_t i = 0; i < loggerCount; i++)
+		{
+			Logger logger = backend->loggers[i];
+			logger->backendRefCount++;
+			snapshot[i] = logger;
+		}
+
+		// Note: Backend threads are shared, so the failure is reported to each attached logger once.
+		uint32_t threadFailCount = logyAtomicLoad32(&backend->threadFailCount);
+		bool isThreadFailed = threadFailCount != backend->reportedFailCount && loggerCount > 0;
+		if (isThreadFailed)
+			backend->reportedFailCount = threadFailCount;
+		unlockMutex(mutex);
+
+		for (size_t i = 0; i < loggerCount; i++)
+		{
+			Logger logger = snapshot[i];
+			if (isThreadFailed)
+				logMessage(logger, WARN_LOG_LEVEL, "Failed to apply backend thread options.");
+
+			lockMutex(logger->backendMutex);
+			nextTime = updateBackendLogger(backend, logger, currentTime, nextTime);
+			unlockMutex(logger->backendMutex);
+
+			lockMutex(mutex);
+			if (--logger->backendRefCount == 0 && backend->detachCount > 0)
+				broadcastCond(backend->detachCond);
+			unlockMutex(mutex);
+		}
+
+		if (!backend->isRunning)
+			break;
+
+		lockMutex(wakeMutex);
+		if (!backend->hasWork && backend->isRunning)
+		{
+			double delay = nextTime - getCurrentClock();
+			if (delay > 0.0)
+				waitCondFor(wakeCond, wakeMutex, (int64_t)(delay * 1000000000.0));
+		}
+		backend->hasWork = false;
+		unlockMutex(wakeMutex);
+	}
+	free(snapshot);
+}
+static void onCompressionUpdate(void* argument)
+{
+	assert(argument);
+	setThreadName("LOG-ZIP");
+
+	LogBackend backend = (LogBackend)argument;
+	if (!applyLogThreadOptions(&backend->threadOptions))
+		logyAtomicFetchAdd32(&backend->threadFailCount, 1);
+
+	Mutex mutex = backend->compressionMutex;
+	Cond cond = backend->compressionCond;
+
+	lockMutex(mutex);
+	while (true)
+	{
+		while (!backend->jobHead && backend->isCompressing)
+			waitCond(cond, mutex);
+
+		CompressionJob* job = backend->jobHead;
+		if (!job)
+			break;
+
+		backend->jobHead = job->next;
+		if (!backend->jobHead)
+			backend->jobTail = NULL;
+		unlockMutex(mutex);
+
+		// Note: Logger may be already destroyed here, so we can't report failure.
+		compressLogFile(NULL, job->filePath);
+		free(job->filePath);
+		free(job);
+
+		lockMutex(mutex);
+	}
+	unlockMutex(mutex);
+}
+
+//**********************************************************************************************************************
+LogyResult createLogBackendExt(uint32_t compressionThreadCount,
+	const LogThreadOptions* threadOptions, LogBackend* backend)
+{
+	assert(backend);
+
+	LogBackend backendInstance = calloc(1, sizeof(LogBackend_T));
+	if (!backendInstance)
+		return FAILED_TO_ALLOCATE_LOGY_RESULT;
+
+	if (threadOptions)
+		backendInstance->threadOptions = *threadOptions;
+	backendInstance->isRunning = true;
+	backendInstance->isCompressing = true;
+
+	Mutex mutex = createMutex();
+	if (!mutex)
+	{
+		destroyLogBackend(backendInstance);
+		return FAILED_TO_ALLOCATE_LOGY_RESULT;
+	}
+	backendInstance->mutex = mutex;
+
+	Mutex wakeMutex = createMutex();
+	if (!wakeMutex)
+	{
+		destroyLogBackend(backendInstance);
+		return FAILED_TO_ALLOCATE_LOGY_RESULT;
+	}
+	backendInstance->wakeMutex = wakeMutex;
+
+	Cond wakeCond = createCond();
+	if (!wakeCond)
+	{
+		destroyLogBackend(backendInstance);
+		return FAILED_TO_ALLOCATE_LOGY_RESULT;
+	}
+	backendInstance->wakeCond = wakeCond;
+
+	Cond detachCond = createCond();
+	if (!detachCond)
+	{
+		destroyLogBackend(backendInstance);
+		return FAILED_TO_ALLOCATE_LOGY_RESULT;
+	}
+	backendInstance->detachCond = detachCond;
+
+	Mutex compressionMutex = createMutex();
+	if (!compressionMutex)
+	{
+		destroyLogBackend(backendInstance);
+		return FAILED_TO_ALLOCATE_LOGY_RESULT;
+	}
+	backendInstance->compressionMutex = compressionMutex;
+
+	Cond compressionCond = createCond();
+	if (!compressionCond)
+	{
+		destroyLogBackend(backendInstance);
+		return FAILED_TO_ALLOCATE_LOGY_RESULT;
+	}
+	backendInstance->compressionCond = compressionCond;
+
+	if (compressionThreadCount > 0)
+	{
+		Thread* compressionThreads = calloc(compressionThreadCount, sizeof(Thread));
+		if (!compressionThreads)
+		{
+			destroyLogBackend(backendInstance);
+			return FAILED_TO_ALLOCATE_LOGY_RESULT;
+		}
+		backendInstance->compressionThreads = compressionThreads;
+
+		for (uint32_t i = 0; i < compressionThreadCount; i++)
+		{
+			Thread thread = createThread(onCompressionUpdate, backendInstance);
+			if (!thread)
+			{
+				destroyLogBackend(backendInstance);
+				return FAILED_TO_ALLOCATE_LOGY_RESULT;
+			}
+			compressionThreads[i] = thread;
+			backendInstance->compressionThreadCount++;
+		}
+	}
+
+	Thread ioThread = createThread(onBackendUpdate, backendInstance);
+	if (!ioThread)
+	{
+		destroyLogBackend(backendInstance);
+		return FAILED_TO_ALLOCATE_LOGY_RESULT;
+	}
+	backendInstance->ioThread = ioThread;
+
+	*backend = backendInstance;
+	return SUCCESS_LOGY_RESULT;
+}
+LogyResult createLogBackend(uint32_t compressionThreadCount, LogBackend* backend)
+{
+	return createLogBackendExt(compressionThreadCount, NULL, backend);
+}
+void destroyLogBackend(LogBackend backend)
+{
+	if (!backend) return;
+	assert(backend->loggerCount == 0); // Destroy all attached loggers before backend!
+
+	Thread ioThread = backend->ioThread;
+	if (ioThread)
+	{
+		lockMutex(backend->wakeMutex);
+		backend->isRunning = false;
+		signalCond(backend->wakeCond);
+		unlockMutex(backend->wakeMutex);
+		joinThread(ioThread);
+		destroyThread(ioThread);
+	}
+
+	Thread* compressionThreads = backend->compressionThreads;
+	if (compressionThreads)
+	{
+		uint32_t compressionThreadCount = backend->compressionThreadCount;
+		lockMutex(backend->compressionMutex);
+		backend->isCompressing = false;
+		broadcastCond(backend->compressionCond);
+		unlockMutex(backend->compressionMutex);
+
+		for (uint32_t i = 0; i < compressionThreadCount; i++)
+		{
+			joinThread(compressionThreads[i]);
+			destroyThread(compressionThreads[i]);
+		}
+		free(compressionThreads);
+	}
+
+	CompressionJob* job = backend->jobHead;
+	while (job)
+	{
+		CompressionJob* next = job->next;
+		free(job->filePath);
+		free(job);
+		job = next;
+	}
+
+	destroyCond(backend->compressionCond);
+	destroyMutex(backend->compressionMutex);
+	destroyCond(backend->detachCond);
+	destroyCond(backend->wakeCond);
+	destroyMutex(backend->wakeMutex);
+	destroyMutex(backend->mutex);
+	free(backend->loggers);
+	free(backend);
+}
+
+//**********************************************************************************************************************
+uint32_t getLogBackendCompressionThreadCount(LogBackend backend)
+{
+	assert(backend);
+	return backend->compressionThreadCount;
+}
+size_t getLogBackendLoggerCount(LogBackend backend)
+{
+	assert(backend);
+	Mutex mutex = backend->mutex;
+	lockMutex(mutex);
+	size_t loggerCount = backend->loggerCount;
+	unlockMutex(mutex);
+	return loggerCount;
+}
+
+//**********************************************************************************************************************
+bool attachLogBackend(LogBackend backend, Logger logger)
+{
+	assert(backend);
+	assert(logger);
+
+	Mutex mutex = backend->mutex;
+	lockMutex(mutex);
+
+	if (backend->loggerCount == backend->loggerCapacity)
+	{
+		size_t loggerCapacity = backend->loggerCapacity > 0 ? backend->loggerCapacity * 2 : 16;
+		Logger* loggers = realloc(backend->loggers, loggerCapacity * sizeof(Logger));
+		if (!loggers)
+		{
+			unlockMutex(mutex);
+			return false;
+		}
+		backend->loggers = loggers;
+		backend->loggerCapacity = loggerCapacity;
+	}
+
+	logger->rotationDelay = getCurrentClock() + logger->rotationTime;
+	backend->loggers[backend->loggerCount++] = logger;
+	unlockMutex(mutex);
+
+	// Note: Waking up backend to reschedule the next rotation time.
+	if (logger->rotationTime > 0.0)
+		wakeLogBackend(backend);
+	return true;
+}
+void detachLogBackend(LogBackend backend, Logger logger)
+{
+	assert(backend);
+	assert(logger);
+
+	Mutex mutex = backend->mutex;
+	lockMutex(mutex);
+
+	Logger* loggers = backend->loggers;
+	size_t loggerCount = backend->loggerCount;
+
+	for (size_t i = 0; i < loggerCount; i++)
+	{
+		if (loggers[i] != logger)
+			continue;
+		loggers[i] = loggers[loggerCount - 1];
+		backend->loggerCount--;
+		break;
+	}
+
+	// Note: Waiting for the I/O thread to finish with its logger array snapshot entry.
+	backend->detachCount++;
+	while (logger->backendRefCount > 0)
+		waitCond(backend->detachCond, mutex);
+	backend->detachCount--;
+	unlockMutex(mutex);
+
+	writeQueuedRecords(logger);
+
+	if (logger->writer)
+	{
+		// Note: Logger is being destroyed, so a failed truncation only leaves zero padding at the file end.
+		destroyLogWriter(logger->writer);
+		logger->writer = NULL;
+	}
+
+	if (logger->rotationTime > 0.0)
+	{
+		lockMutex(logger->mutex);
+		char* filePath = logger->filePath;
+		logger->filePath = NULL;
+		unlockMutex(logger->mutex);
+		enqueueCompression(backend, filePath);
+	}
+}
+void wakeLogBackend(LogBackend backend)
+{
+	assert(backend);
+	Mutex wakeMutex = backend->wakeMutex;
+	lockMutex(wakeMutex);
+	backend->hasWork = true;
+	signalCond(backend->wakeCond);
+	unlockMutex(wakeMutex);
+}
+void flushLogBackend(LogBackend backend, Logger logger)
+{
+	assert(backend);
+	assert(logger);
+	Mutex mutex = logger->backendMutex;
+	lockMutex(mutex);
+	writeQueuedRecords(logger);
+	unlockMutex(mutex);
+}
@@ -0,0 +1,202 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "logy/callsite.h"
+#include "internal.h"
+
+#include <string.h>
+
+// Note: Registry pages are never reallocated, so call-sites can be read by identifier without locking.
+//       Registration is rare (once per statement), so it uses a simple spin lock, which does not require
+//       creation and can't fail, unlike the mutex.
+
+#define CALL_SITE_PAGE_SIZE 1024
+#define CALL_SITE_PAGE_COUNT 1024
+#define CALL_SITE_BUCKET_COUNT 4096
+
+static LogCallSite** volatile callSitePages[CALL_SITE_PAGE_COUNT];
+static uint32_t callSiteBuckets[CALL_SITE_BUCKET_COUNT];
+static uint32_t* callSiteChains = NULL;
+static uint32_t callSiteChainCapacity = 0;
+static volatile uint32_t callSiteCount = 0;
+static volatile uint32_t registryLock = 0;
+
+//**********************************************************************************************************************
+static uint32_t hashCallSite(const char* filePath, const char* fmt, uint32_t line)
+{
+	// Note: FNV-1a hash of the call-site file path, format and line.
+	uint32_t hash = 2166136261u;
+	while (*filePath) { hash ^= (uint8_t)*filePath++; hash *= 16777619u; }
+	while (*fmt) { hash ^= (uint8_t)*fmt++; hash *= 16777619u; }
+	hash ^= line; hash *= 16777619u;
+	return hash;
+}
+static const char* getFileName(const char* filePath)
+{
+	const char* fileName = filePath;
+	for (const char* c = filePath; *c; c++)
+	{
+		if (*c == '/' || *c == '\\')
+			fileName = c + 1;
+	}
+	return fileName;
+}
+inline static LogCallSite* getRegisteredCallSite(uint32_t id)
+{
+	uint32_t index = id - 1;
+	return callSitePages[index / CALL_SITE_PAGE_SIZE][index % CALL_SITE_PAGE_SIZE];
+}
+
+//**********************************************************************************************************************
+uint32_t registerLogCallSite(LogCallSite* callSite)
+{
+	assert(callSite);
+	assert(callSite->filePath);
+	assert(callSite->fmt);
+
+	uint32_t id = logyAtomicLoad32(&callSite->id);
+	if (id != 0)
+		return id;
+
+	uint32_t hash = hashCallSite(callSite->filePath, callSite->fmt, callSite->line);
+	uint32_t bucket = hash % CALL_SITE_BUCKET_COUNT;
+
+	lockLogSpin(&registryLock);
+
+	id = logyAtomicLoad32(&callSite->id);
+	if (id != 0)
+	{
+		unlockLogSpin(&registryLock);
+		return id;
+	}
+
+	// Note: Interning call-sites, same statement can be compiled into many translation units.
+	uint32_t chainId = callSiteBuckets[bucket];
+	while (chainId != 0)
+	{
+		const LogCallSite* other = getRegisteredCallSite(chainId);
+		if (other->line == callSite->line && strcmp(other->filePath, callSite->filePath) == 0 &&
+			strcmp(other->fmt, callSite->fmt) == 0)
+		{
+			callSite->fileName = other->fileName;
+			logyAtomicStore32(&callSite->id, chainId);
+			unlockLogSpin(&registryLock);
+			return chainId;
+		}
+		chainId = callSiteChains[chainId - 1];
+	}
+
+	uint32_t index = callSiteCount;
+	uint32_t pageIndex = index / CALL_SITE_PAGE_SIZE;
+
+	if (pageIndex >= CALL_SITE_PAGE_COUNT)
+	{
+		unlockLogSpin(&registryLock);
+		return 0;
+	}
+
+	if (index == callSiteChainCapacity)
+	{
+		uint32_t chainCapacity = callSiteChainCapacity > 0 ? callSiteChainCapacity * 2 : CALL_SITE_PAGE_SIZE;
+		uint32_t* chains = realloc(callSiteChains, chainCapacity * sizeof(uint32_t));
+		if (!chains)
+		{
+			unlockLogSpin(&registryLock);
+			return 0;
+		}
+		callSiteChains = chains;
+		callSiteChainCapacity = chainCapacity;
+	}
+
+	LogCallSite** page = callSitePages[pageIndex];
+	if (!page)
+	{
+		page = malloc(CALL_SITE_PAGE_SIZE * sizeof(LogCallSite*));
+		if (!page)
+		{
+			unlockLogSpin(&registryLock);
+			return 0;
+		}
+		(void)logyAtomicExchangePointer(&callSitePages[pageIndex], page);
+	}
+
+	id = index + 1;
+	callSite->fileName = getFileName(callSite->filePath);
+	page[index % CALL_SITE_PAGE_SIZE] = callSite;
+	callSiteChains[index] = callSiteBuckets[bucket];
+	callSiteBuckets[bucket] = id;
+
+	logyAtomicStore32(&callSiteCount, id);
+	logyAtomicStore32(&callSite->id, id);
+	unlockLogSpin(&registryLock);
+	return id;
+}
+
+uint32_t getLogCallSiteCount()
+{
+	return logyAtomicLoad32(&callSiteCount);
+}
+const LogCallSite* getLogCallSite(uint32_t id)
+{
+	if (id == 0 || id > logyAtomicLoad32(&callSiteCount))
+		return NULL;
+	return getRegisteredCallSite(id);
+}
+void setLogCallSiteEnabled(uint32_t id, bool isEnabled)
+{
+	assert(id > 0 && id <= logyAtomicLoad32(&callSiteCount));
+	LogCallSite* callSite = getRegisteredCallSite(id);
+	callSite->isDisabled = !isEnabled;
+}
+
+//**********************************************************************************************************************
+void logCallSiteMessageVA(Logger logger, LogCallSite* callSite, const char* fmt, va_list args)
+{
+	assert(logger);
+	assert(callSite);
+	assert(callSite->level < ALL_LOG_LEVEL);
+	assert(fmt);
+
+	LogLevel level = callSite->level;
+	bool isEnabled = level <= logyAtomicLoad32(&logger->level);
+	if (!isEnabled && !isLogDeferralActive())
+		return;
+
+	uint32_t id = logyAtomicLoad32(&callSite->id);
+	if (id == 0)
+		id = registerLogCallSite(callSite);
+
+	// Note: Interned call-site copies share the enabled state of the registered one.
+	const LogCallSite* registeredSite = id != 0 ? getRegisteredCallSite(id) : callSite;
+	if (registeredSite->isDisabled)
+		return;
+
+	if (isEnabled)
+	{
+		if (!isLogMessageShed(logger, level))
+			writeLogMessageVA(logger, NULL, callSite, level, fmt, args);
+	}
+	else
+		deferLogMessageVA(logger, NULL, callSite, level, fmt, args);
+}
+void logCallSiteMessage(Logger logger, LogCallSite* callSite, const char* fmt, ...)
+{
+	assert(logger);
+	assert(callSite);
+	assert(fmt);
+	va_list args;
+	va_start(args, fmt);
+	logCallSiteMessageVA(logger, callSite, fmt, args);
+	va_end(args);
+}
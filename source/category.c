@@ -0,0 +1,227 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "logy/category.h"
+#include "internal.h"
+
+#include <string.h>
+
+#define INHERIT_LOG_LEVEL -1
+
+struct LogCategory_T
+{
+	Logger logger;
+	char* name;
+	size_t nameLength;
+	int32_t ownLevel;
+	volatile uint32_t level;
+};
+
+//**********************************************************************************************************************
+static bool isParentCategory(LogCategory parent, LogCategory child)
+{
+	size_t parentLength = parent->nameLength;
+	return parentLength < child->nameLength && child->name[parentLength] == '.' &&
+		memcmp(parent->name, child->name, parentLength * sizeof(char)) == 0;
+}
+void updateLogCategoryLevels(Logger logger)
+{
+	assert(logger);
+
+	LogCategory* categories = logger->categories;
+	size_t categoryCount = logger->categoryCount;
+	uint32_t loggerLevel = logyAtomicLoad32(&logger->level);
+
+	for (size_t i = 0; i < categoryCount; i++)
+	{
+		LogCategory category = categories[i];
+		int32_t level = category->ownLevel;
+
+		if (level == INHERIT_LOG_LEVEL)
+		{
+			// Note: Searching for the nearest parent with its own level, it has the longest name.
+			size_t parentLength = 0;
+			level = (int32_t)loggerLevel;
+
+			for (size_t j = 0; j < categoryCount; j++)
+			{
+				LogCategory parent = categories[j];
+				if (parent->ownLevel == INHERIT_LOG_LEVEL || parent->nameLength <= parentLength ||
+					!isParentCategory(parent, category))
+				{
+					continue;
+				}
+
+				level = parent->ownLevel;
+				parentLength = parent->nameLength;
+			}
+		}
+
+		logyAtomicStore32(&category->level, (uint32_t)level);
+	}
+}
+void destroyLogCategories(Logger logger)
+{
+	assert(logger);
+
+	LogCategory* categories = logger->categories;
+	size_t categoryCount = logger->categoryCount;
+
+	for (size_t i = 0; i < categoryCount; i++)
+	{
+		free(categories[i]->name);
+		free(categories[i]);
+	}
+
+	free(categories);
+}
+
+//**********************************************************************************************************************
+LogyResult getLogCategory(Logger logger, const char* name, LogCategory* category)
+{
+	assert(logger);
+	assert(name);
+	assert(category);
+
+	size_t nameLength = strlen(name);
+	assert(nameLength > 0);
+
+	Mutex mutex = logger->mutex;
+	lockMutex(mutex);
+
+	LogCategory* categories = logger->categories;
+	size_t categoryCount = logger->categoryCount;
+
+	for (size_t i = 0; i < categoryCount; i++)
+	{
+		LogCategory instance = categories[i];
+		if (instance->nameLength != nameLength || memcmp(instance->name, name, nameLength * sizeof(char)) != 0)
+			continue;
+
+		unlockMutex(mutex);
+		*category = instance;
+		return SUCCESS_LOGY_RESULT;
+	}
+
+	if (categoryCount == logger->categoryCapacity)
+	{
+		size_t categoryCapacity = categoryCount > 0 ? categoryCount * 2 : 16;
+		categories = realloc(categories, categoryCapacity * sizeof(LogCategory));
+		if (!categories)
+		{
+			unlockMutex(mutex);
+			return FAILED_TO_ALLOCATE_LOGY_RESULT;
+		}
+		logger->categories = categories;
+		logger->categoryCapacity = categoryCapacity;
+	}
+
+	LogCategory categoryInstance = calloc(1, sizeof(LogCategory_T));
+	if (!categoryInstance)
+	{
+		unlockMutex(mutex);
+		return FAILED_TO_ALLOCATE_LOGY_RESULT;
+	}
+
+	char* categoryName = malloc((nameLength + 1) * sizeof(char));
+	if (!categoryName)
+	{
+		unlockMutex(mutex);
+		free(categoryInstance);
+		return FAILED_TO_ALLOCATE_LOGY_RESULT;
+	}
+
+	memcpy(categoryName, name, (nameLength + 1) * sizeof(char));
+	categoryInstance->logger = logger;
+	categoryInstance->name = categoryName;
+	categoryInstance->nameLength = nameLength;
+	categoryInstance->ownLevel = INHERIT_LOG_LEVEL;
+
+	categories[logger->categoryCount++] = categoryInstance;
+	updateLogCategoryLevels(logger);
+	unlockMutex(mutex);
+
+	*category = categoryInstance;
+	return SUCCESS_LOGY_RESULT;
+}
+
+//**********************************************************************************************************************
+Logger getLogCategoryLogger(LogCategory category)
+{
+	assert(category);
+	return category->logger;
+}
+const char* getLogCategoryName(LogCategory category)
+{
+	assert(category);
+	return category->name;
+}
+
+LogLevel getLogCategoryLevel(LogCategory category)
+{
+	assert(category);
+	return (LogLevel)logyAtomicLoad32(&category->level);
+}
+void setLogCategoryLevel(LogCategory category, LogLevel level)
+{
+	assert(category);
+	assert(level <= ALL_LOG_LEVEL);
+	Mutex mutex = category->logger->mutex;
+	lockMutex(mutex);
+	category->ownLevel = level;
+	updateLogCategoryLevels(category->logger);
+	unlockMutex(mutex);
+}
+void resetLogCategoryLevel(LogCategory category)
+{
+	assert(category);
+	Mutex mutex = category->logger->mutex;
+	lockMutex(mutex);
+	category->ownLevel = INHERIT_LOG_LEVEL;
+	updateLogCategoryLevels(category->logger);
+	unlockMutex(mutex);
+}
+
+bool isLogCategoryEnabled(LogCategory category, LogLevel level)
+{
+	assert(category);
+	return level <= logyAtomicLoad32(&category->level);
+}
+
+//**********************************************************************************************************************
+void logCategoryMessageVA(LogCategory category, LogLevel level, const char* fmt, va_list args)
+{
+	assert(category);
+	assert(level < ALL_LOG_LEVEL);
+	assert(fmt);
+
+	if (level > logyAtomicLoad32(&category->level))
+	{
+		deferLogMessageVA(category->logger, category->name, NULL, level, fmt, args);
+		return;
+	}
+	if (isLogMessageShed(category->logger, level))
+		return;
+	writeLogMessageVA(category->logger, category->name, NULL, level, fmt, args);
+}
+void logCategoryMessage(LogCategory category, LogLevel level, const char* fmt, ...)
+{
+	assert(category);
+	assert(level < ALL_LOG_LEVEL);
+	assert(fmt);
+	va_list args;
+	va_start(args, fmt);
+	logCategoryMessageVA(category, level, fmt, args);
+	va_end(args);
+}
@@ -0,0 +1,233 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "logy/context.h"
+#include "internal.h"
+
+#include <string.h>
+
+// Note: Key-value pairs are stored as "key\0value\0" strings in a single buffer, which is kept when the
+//       context becomes empty, so scoped pushes do not reallocate it. Buffers are freed by the clearLogContext(),
+//       which is also called on the thread exit, so threads do not leak them.
+
+typedef struct ThreadLogContext
+{
+	char* data;
+	uint32_t* offsets;
+	size_t dataSize;
+	size_t dataCapacity;
+	uint32_t count;
+	uint32_t capacity;
+	char prefix[LOG_CONTEXT_PREFIX_LENGTH + 1];
+} ThreadLogContext;
+
+struct LogContext_T
+{
+	char* data;
+	size_t dataSize;
+	uint32_t count;
+};
+
+static LOGY_THREAD_LOCAL ThreadLogContext threadLogContext;
+
+//**********************************************************************************************************************
+static void renderLogContextPrefix(ThreadLogContext* context)
+{
+	assert(context);
+
+	char* prefix = context->prefix;
+	const char* data = context->data;
+	const uint32_t* offsets = context->offsets;
+	uint32_t count = context->count;
+	size_t length = 0;
+
+	// Note: Reserving space for the " ..." truncation suffix.
+	const size_t maxLength = LOG_CONTEXT_PREFIX_LENGTH - 4;
+	prefix[0] = '\0';
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		const char* key = data + offsets[i];
+		const char* value = key + strlen(key) + 1;
+
+		int pairLength = snprintf(prefix + length, maxLength + 1 - length,
+			"%s%s=%s", i > 0 ? " " : "", key, value);
+		if (pairLength < 0 || (size_t)pairLength > maxLength - length)
+		{
+			memcpy(prefix + length, i > 0 ? " ..." : "...", (i > 0 ? 5 : 4) * sizeof(char));
+			return;
+		}
+		length += pairLength;
+	}
+}
+static bool reserveLogContext(ThreadLogContext* context, size_t dataSize, uint32_t count)
+{
+	assert(context);
+
+	if (context->dataCapacity == 0)
+		watchLogThreadExit();
+
+	if (dataSize > context->dataCapacity)
+	{
+		size_t dataCapacity = context->dataCapacity > 0 ? context->dataCapacity * 2 : 128;
+		while (dataCapacity < dataSize)
+			dataCapacity *= 2;
+		char* data = realloc(context->data, dataCapacity * sizeof(char));
+		if (!data) return false;
+		context->data = data;
+		context->dataCapacity = dataCapacity;
+	}
+
+	if (count > context->capacity)
+	{
+		uint32_t capacity = context->capacity > 0 ? context->capacity * 2 : 8;
+		while (capacity < count)
+			capacity *= 2;
+		uint32_t* offsets = realloc(context->offsets, capacity * sizeof(uint32_t));
+		if (!offsets) return false;
+		context->offsets = offsets;
+		context->capacity = capacity;
+	}
+	return true;
+}
+static void resetLogContext(ThreadLogContext* context)
+{
+	assert(context);
+	context->dataSize = 0;
+	context->count = 0;
+	context->prefix[0] = '\0';
+}
+
+//**********************************************************************************************************************
+LogyResult pushLogContext(const char* key, const char* value)
+{
+	assert(key);
+	assert(value);
+
+	ThreadLogContext* context = &threadLogContext;
+	size_t keySize = strlen(key) + 1;
+	size_t valueSize = strlen(value) + 1;
+	size_t dataSize = context->dataSize;
+
+	if (!reserveLogContext(context, dataSize + keySize + valueSize, context->count + 1))
+		return FAILED_TO_ALLOCATE_LOGY_RESULT;
+
+	char* data = context->data + dataSize;
+	memcpy(data, key, keySize * sizeof(char));
+	memcpy(data + keySize, value, valueSize * sizeof(char));
+	context->offsets[context->count++] = (uint32_t)dataSize;
+	context->dataSize = dataSize + keySize + valueSize;
+	renderLogContextPrefix(context);
+	return SUCCESS_LOGY_RESULT;
+}
+void popLogContext()
+{
+	ThreadLogContext* context = &threadLogContext;
+	assert(context->count > 0); // Context is empty!
+
+	if (context->count == 1)
+	{
+		resetLogContext(context);
+		return;
+	}
+
+	context->dataSize = context->offsets[--context->count];
+	renderLogContextPrefix(context);
+}
+void clearLogContext()
+{
+	ThreadLogContext* context = &threadLogContext;
+	free(context->data);
+	free(context->offsets);
+	memset(context, 0, sizeof(ThreadLogContext));
+}
+
+uint32_t getLogContextSize()
+{
+	return threadLogContext.count;
+}
+const char* getLogContextPrefix()
+{
+	return threadLogContext.prefix;
+}
+
+//**********************************************************************************************************************
+LogyResult captureLogContext(LogContext* context)
+{
+	assert(context);
+
+	LogContext contextInstance = calloc(1, sizeof(LogContext_T));
+	if (!contextInstance)
+		return FAILED_TO_ALLOCATE_LOGY_RESULT;
+
+	const ThreadLogContext* threadContext = &threadLogContext;
+	size_t dataSize = threadContext->dataSize;
+
+	if (dataSize > 0)
+	{
+		char* data = malloc(dataSize * sizeof(char));
+		if (!data)
+		{
+			destroyLogContext(contextInstance);
+			return FAILED_TO_ALLOCATE_LOGY_RESULT;
+		}
+
+		memcpy(data, threadContext->data, dataSize * sizeof(char));
+		contextInstance->data = data;
+		contextInstance->dataSize = dataSize;
+		contextInstance->count = threadContext->count;
+	}
+
+	*context = contextInstance;
+	return SUCCESS_LOGY_RESULT;
+}
+void destroyLogContext(LogContext context)
+{
+	if (!context) return;
+	free(context->data);
+	free(context);
+}
+
+LogyResult restoreLogContext(LogContext context)
+{
+	if (!context || context->count == 0)
+	{
+		resetLogContext(&threadLogContext);
+		return SUCCESS_LOGY_RESULT;
+	}
+
+	ThreadLogContext* threadContext = &threadLogContext;
+	size_t dataSize = context->dataSize;
+	uint32_t count = context->count;
+
+	if (!reserveLogContext(threadContext, dataSize, count))
+		return FAILED_TO_ALLOCATE_LOGY_RESULT;
+
+	char* data = threadContext->data;
+	uint32_t* offsets = threadContext->offsets;
+	memcpy(data, context->data, dataSize * sizeof(char));
+
+	size_t offset = 0;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		offsets[i] = (uint32_t)offset;
+		offset += strlen(data + offset) + 1; // Key
+		offset += strlen(data + offset) + 1; // Value
+	}
+
+	threadContext->dataSize = dataSize;
+	threadContext->count = count;
+	renderLogContextPrefix(threadContext);
+	return SUCCESS_LOGY_RESULT;
+}
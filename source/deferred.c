@@ -0,0 +1,748 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "logy/deferred.h"
+#include "internal.h"
+
+#include <wchar.h>
+#include <stddef.h>
+#include <string.h>
+
+// Note: Deferred message stores its format string and the argument values, in the format order.
+//       Format and strings are copied, because they can be freed before the scope end. Formats which
+//       can't be captured (positional or wide string arguments) are formatted on capture instead.
+
+#define DEFERRED_TEXT_BUFFER_SIZE 1024
+#define DEFERRED_SPEC_BUFFER_SIZE 64
+#define NULL_DEFERRED_STRING UINT32_MAX
+
+typedef enum FormatLength
+{
+	NONE_FORMAT_LENGTH, HH_FORMAT_LENGTH, H_FORMAT_LENGTH, L_FORMAT_LENGTH, LL_FORMAT_LENGTH,
+	J_FORMAT_LENGTH, Z_FORMAT_LENGTH, T_FORMAT_LENGTH, BIG_L_FORMAT_LENGTH,
+} FormatLength;
+
+typedef enum CaptureResult
+{
+	SUCCESS_CAPTURE_RESULT, UNSUPPORTED_CAPTURE_RESULT, FULL_CAPTURE_RESULT,
+} CaptureResult;
+
+typedef struct FormatSpec
+{
+	const char* begin;
+	const char* end;
+	int32_t precision;
+	uint8_t length;
+	uint8_t starCount;
+	bool isStarPrecision;
+	char conversion;
+} FormatSpec;
+
+typedef struct DeferredMessage
+{
+	const char* category;
+	const LogCallSite* callSite;
+	time_t rawTime;
+	uint32_t size;
+	uint16_t milliseconds;
+	uint16_t contextLength;
+	LogLevel level;
+	bool isFormatted;
+} DeferredMessage;
+
+typedef struct DeferredText
+{
+	char* data;
+	size_t length;
+	size_t capacity;
+	char buffer[DEFERRED_TEXT_BUFFER_SIZE];
+} DeferredText;
+
+typedef struct LogDeferral
+{
+	struct LogDeferral* previous;
+	Logger logger;
+	uint8_t* buffer;
+	size_t bufferSize;
+	size_t size;
+	uint32_t dropCount;
+	LogLevel level;
+	bool isFailed;
+	char threadName[16];
+} LogDeferral;
+
+static LOGY_THREAD_LOCAL LogDeferral* threadLogDeferral = NULL;
+
+//**********************************************************************************************************************
+static const char* parseFormatSpec(const char* fmt, FormatSpec* spec)
+{
+	assert(fmt);
+	assert(*fmt == '%');
+	assert(spec);
+
+	const char* c = fmt + 1;
+	int32_t precision = -1;
+	uint8_t starCount = 0;
+	bool isStarPrecision = false;
+
+	while (*c == '-' || *c == '+' || *c == ' ' || *c == '#' || *c == '0' || *c == '\'')
+		c++;
+
+	if (*c == '*') { starCount++; c++; }
+	else { while (*c >= '0' && *c <= '9') c++; }
+
+	if (*c == '.')
+	{
+		c++;
+		if (*c == '*') { starCount++; isStarPrecision = true; c++; }
+		else
+		{
+			precision = 0;
+			while (*c >= '0' && *c <= '9')
+			{
+				if (precision < INT32_MAX / 10)
+					precision = precision * 10 + (*c - '0');
+				c++;
+			}
+		}
+	}
+
+	uint8_t length = NONE_FORMAT_LENGTH;
+	switch (*c)
+	{
+	case 'h':
+		if (c[1] == 'h') { length = HH_FORMAT_LENGTH; c += 2; }
+		else { length = H_FORMAT_LENGTH; c++; }
+		break;
+	case 'l':
+		if (c[1] == 'l') { length = LL_FORMAT_LENGTH; c += 2; }
+		else { length = L_FORMAT_LENGTH; c++; }
+		break;
+	case 'j': length = J_FORMAT_LENGTH; c++; break;
+	case 'z': length = Z_FORMAT_LENGTH; c++; break;
+	case 't': length = T_FORMAT_LENGTH; c++; break;
+	case 'L': length = BIG_L_FORMAT_LENGTH; c++; break;
+	default: break;
+	}
+
+	char conversion = *c;
+	if (conversion == '\0' || !strchr("diouxXcseEfFgGaAp", conversion) ||
+		(conversion == 's' && length == L_FORMAT_LENGTH))
+	{
+		return NULL;
+	}
+
+	spec->begin = fmt;
+	spec->end = c + 1;
+	spec->precision = precision;
+	spec->length = length;
+	spec->starCount = starCount;
+	spec->isStarPrecision = isStarPrecision;
+	spec->conversion = conversion;
+	return c + 1;
+}
+
+//**********************************************************************************************************************
+static bool writeDeferredValue(uint8_t* buffer, size_t capacity, size_t* offset, const void* value, size_t size)
+{
+	if (*offset + size > capacity)
+		return false;
+	memcpy(buffer + *offset, value, size);
+	*offset += size;
+	return true;
+}
+static CaptureResult captureDeferredArgs(uint8_t* buffer,
+	size_t capacity, size_t* offset, const char* fmt, va_list* args)
+{
+	const char* c = fmt;
+	while (*c)
+	{
+		if (*c != '%') { c++; continue; }
+		if (c[1] == '%') { c += 2; continue; }
+
+		FormatSpec spec;
+		c = parseFormatSpec(c, &spec);
+		if (!c) return UNSUPPORTED_CAPTURE_RESULT;
+
+		// Note: Precision star is the last one, negative precision value is the same as omitted.
+		for (uint8_t i = 0; i < spec.starCount; i++)
+		{
+			int64_t star = va_arg(*args, int);
+			if (!writeDeferredValue(buffer, capacity, offset, &star, sizeof(int64_t)))
+				return FULL_CAPTURE_RESULT;
+			if (spec.isStarPrecision && i + 1 == spec.starCount)
+				spec.precision = star < 0 ? -1 : (int32_t)star;
+		}
+
+		uint8_t length = spec.length;
+		switch (spec.conversion)
+		{
+		case 'd': case 'i':
+		{
+			int64_t value;
+			switch (length)
+			{
+			default: value = va_arg(*args, int); break;
+			case L_FORMAT_LENGTH: value = va_arg(*args, long); break;
+			case LL_FORMAT_LENGTH: value = va_arg(*args, long long); break;
+			case J_FORMAT_LENGTH: value = va_arg(*args, intmax_t); break;
+			case Z_FORMAT_LENGTH: value = (int64_t)va_arg(*args, size_t); break;
+			case T_FORMAT_LENGTH: value = va_arg(*args, ptrdiff_t); break;
+			}
+			if (!writeDeferredValue(buffer, capacity, offset, &value, sizeof(int64_t)))
+				return FULL_CAPTURE_RESULT;
+			break;
+		}
+		case 'o': case 'u': case 'x': case 'X':
+		{
+			uint64_t value;
+			switch (length)
+			{
+			default: value = va_arg(*args, unsigned int); break;
+			case L_FORMAT_LENGTH: value = va_arg(*args, unsigned long); break;
+			case LL_FORMAT_LENGTH: value = va_arg(*args, unsigned long long); break;
+			case J_FORMAT_LENGTH: value = va_arg(*args, uintmax_t); break;
+			case Z_FORMAT_LENGTH: value = va_arg(*args, size_t); break;
+			case T_FORMAT_LENGTH: value = (uint64_t)va_arg(*args, ptrdiff_t); break;
+			}
+			if (!writeDeferredValue(buffer, capacity, offset, &value, sizeof(uint64_t)))
+				return FULL_CAPTURE_RESULT;
+			break;
+		}
+		case 'c':
+		{
+			int64_t value = length == L_FORMAT_LENGTH ? (int64_t)va_arg(*args, wint_t) : va_arg(*args, int);
+			if (!writeDeferredValue(buffer, capacity, offset, &value, sizeof(int64_t)))
+				return FULL_CAPTURE_RESULT;
+			break;
+		}
+		case 'p':
+		{
+			void* value = va_arg(*args, void*);
+			if (!writeDeferredValue(buffer, capacity, offset, &value, sizeof(void*)))
+				return FULL_CAPTURE_RESULT;
+			break;
+		}
+		case 's':
+		{
+			// Note: String with the precision is not required to be null terminated, see the printf.
+			const char* value = va_arg(*args, const char*);
+			uint32_t stringLength = NULL_DEFERRED_STRING;
+			if (value && spec.precision >= 0)
+			{
+				const char* end = memchr(value, '\0', (size_t)spec.precision);
+				stringLength = end ? (uint32_t)(end - value) : (uint32_t)spec.precision;
+			}
+			else if (value)
+			{
+				stringLength = (uint32_t)strlen(value);
+			}
+			if (!writeDeferredValue(buffer, capacity, offset, &stringLength, sizeof(uint32_t)))
+				return FULL_CAPTURE_RESULT;
+			if (value)
+			{
+				char terminator = '\0';
+				if (!writeDeferredValue(buffer, capacity, offset, value, stringLength * sizeof(char)) ||
+					!writeDeferredValue(buffer, capacity, offset, &terminator, sizeof(char)))
+				{
+					return FULL_CAPTURE_RESULT;
+				}
+			}
+			break;
+		}
+		default:
+			if (length == BIG_L_FORMAT_LENGTH)
+			{
+				long double value = va_arg(*args, long double);
+				if (!writeDeferredValue(buffer, capacity, offset, &value, sizeof(long double)))
+					return FULL_CAPTURE_RESULT;
+			}
+			else
+			{
+				double value = va_arg(*args, double);
+				if (!writeDeferredValue(buffer, capacity, offset, &value, sizeof(double)))
+					return FULL_CAPTURE_RESULT;
+			}
+			break;
+		}
+	}
+	return SUCCESS_CAPTURE_RESULT;
+}
+static bool captureDeferredMessage(LogDeferral* deferral, const char* category, const LogCallSite* callSite,
+	LogLevel level, const char* context, const char* fmt, va_list args)
+{
+	assert(deferral);
+	assert(context);
+	assert(fmt);
+
+	uint8_t* buffer = deferral->buffer;
+	size_t capacity = deferral->bufferSize;
+	size_t messageOffset = deferral->size;
+	size_t offset = messageOffset + sizeof(DeferredMessage);
+	size_t contextLength = strlen(context);
+
+	if (contextLength > 0 && !writeDeferredValue(buffer, capacity, &offset, context, (contextLength + 1) * sizeof(char)))
+		return false;
+
+	size_t formatOffset = offset;
+	if (!writeDeferredValue(buffer, capacity, &offset, fmt, (strlen(fmt) + 1) * sizeof(char)))
+		return false;
+
+	va_list captureArgs;
+	va_copy(captureArgs, args);
+	CaptureResult result = captureDeferredArgs(buffer, capacity, &offset, fmt, &captureArgs);
+	va_end(captureArgs);
+
+	if (result == FULL_CAPTURE_RESULT)
+		return false;
+
+	bool isFormatted = result == UNSUPPORTED_CAPTURE_RESULT;
+	if (isFormatted)
+	{
+		va_list formatArgs;
+		va_copy(formatArgs, args);
+		int messageLength = vsnprintf(NULL, 0, fmt, formatArgs);
+		va_end(formatArgs);
+
+		// Note: Formatted message is stored as a single string argument, without the format copy.
+		offset = formatOffset + sizeof(uint32_t);
+		if (messageLength < 0 || offset + messageLength + 1 > capacity)
+			return false;
+
+		uint32_t stringLength = (uint32_t)messageLength;
+		memcpy(buffer + formatOffset, &stringLength, sizeof(uint32_t));
+		va_copy(formatArgs, args);
+		vsnprintf((char*)buffer + offset, messageLength + 1, fmt, formatArgs);
+		va_end(formatArgs);
+		offset += messageLength + 1;
+	}
+
+	time_t rawTime;
+	int milliseconds;
+	getLogHeaderTime(&rawTime, &milliseconds);
+
+	// Note: Buffer size is aligned, so the aligned message end is never out of the buffer.
+	size_t messageSize = (offset - messageOffset + 7) & ~(size_t)7;
+	DeferredMessage* message = (DeferredMessage*)(buffer + messageOffset);
+	message->category = category;
+	message->callSite = callSite;
+	message->rawTime = rawTime;
+	message->size = (uint32_t)messageSize;
+	message->milliseconds = (uint16_t)milliseconds;
+	message->contextLength = (uint16_t)contextLength;
+	message->level = level;
+	message->isFormatted = isFormatted;
+	deferral->size = messageOffset + messageSize;
+	return true;
+}
+
+//**********************************************************************************************************************
+static bool reserveDeferredText(DeferredText* text, size_t capacity)
+{
+	assert(text);
+
+	if (capacity <= text->capacity)
+		return true;
+
+	size_t newCapacity = text->capacity * 2;
+	while (newCapacity < capacity)
+		newCapacity *= 2;
+
+	char* data;
+	if (text->data == text->buffer)
+	{
+		data = malloc(newCapacity * sizeof(char));
+		if (!data) return false;
+		memcpy(data, text->buffer, text->length * sizeof(char));
+	}
+	else
+	{
+		data = realloc(text->data, newCapacity * sizeof(char));
+		if (!data) return false;
+	}
+
+	text->data = data;
+	text->capacity = newCapacity;
+	return true;
+}
+static bool appendDeferredText(DeferredText* text, const char* string, size_t length)
+{
+	assert(text);
+	assert(string);
+
+	if (!reserveDeferredText(text, text->length + length + 1))
+		return false;
+	memcpy(text->data + text->length, string, length * sizeof(char));
+	text->length += length;
+	text->data[text->length] = '\0';
+	return true;
+}
+static bool formatDeferredText(DeferredText* text, const char* spec, ...)
+{
+	assert(text);
+	assert(spec);
+
+	size_t available = text->capacity - text->length;
+	va_list args;
+	va_start(args, spec);
+	int length = vsnprintf(text->data + text->length, available, spec, args);
+	va_end(args);
+
+	if (length < 0)
+		return false;
+
+	if ((size_t)length >= available)
+	{
+		if (!reserveDeferredText(text, text->length + length + 1))
+			return false;
+		va_start(args, spec);
+		vsnprintf(text->data + text->length, length + 1, spec, args);
+		va_end(args);
+	}
+
+	text->length += length;
+	return true;
+}
+
+//**********************************************************************************************************************
+static const void* readDeferredValue(const uint8_t* buffer, size_t* offset, size_t size)
+{
+	const void* value = buffer + *offset;
+	*offset += size;
+	return value;
+}
+static bool buildDeferredSpec(const FormatSpec* formatSpec,
+	const uint8_t* buffer, size_t* offset, char* spec)
+{
+	// Note: Replacing '*' width and precision with the captured values.
+	size_t length = 0;
+	for (const char* c = formatSpec->begin; c != formatSpec->end; c++)
+	{
+		if (*c != '*')
+		{
+			if (length + 1 >= DEFERRED_SPEC_BUFFER_SIZE) return false;
+			spec[length++] = *c;
+			continue;
+		}
+
+		int64_t star;
+		memcpy(&star, readDeferredValue(buffer, offset, sizeof(int64_t)), sizeof(int64_t));
+
+		// Note: Negative precision is the same as the omitted one.
+		if (length > 0 && spec[length - 1] == '.' && star < 0)
+		{
+			length--;
+			continue;
+		}
+
+		int starLength = snprintf(spec + length, DEFERRED_SPEC_BUFFER_SIZE - length, "%lld", (long long)star);
+		if (starLength < 0 || length + starLength + 1 >= DEFERRED_SPEC_BUFFER_SIZE) return false;
+		length += starLength;
+	}
+
+	spec[length] = '\0';
+	return true;
+}
+static bool replayDeferredMessage(const char* fmt, const uint8_t* buffer, size_t offset, DeferredText* text)
+{
+	assert(fmt);
+	assert(buffer);
+	assert(text);
+
+	const char* c = fmt;
+	while (*c)
+	{
+		const char* literal = c;
+		while (*c && *c != '%')
+			c++;
+		if (c != literal && !appendDeferredText(text, literal, c - literal))
+			return false;
+		if (*c == '\0')
+			break;
+
+		if (c[1] == '%')
+		{
+			if (!appendDeferredText(text, "%", 1)) return false;
+			c += 2;
+			continue;
+		}
+
+		FormatSpec formatSpec;
+		c = parseFormatSpec(c, &formatSpec);
+		assert(c); // Unsupported formats are not captured.
+
+		char spec[DEFERRED_SPEC_BUFFER_SIZE];
+		if (!buildDeferredSpec(&formatSpec, buffer, &offset, spec))
+			return false;
+
+		uint8_t length = formatSpec.length;
+		bool isFormatted;
+
+		switch (formatSpec.conversion)
+		{
+		case 'd': case 'i':
+		{
+			int64_t value;
+			memcpy(&value, readDeferredValue(buffer, &offset, sizeof(int64_t)), sizeof(int64_t));
+			switch (length)
+			{
+			default: isFormatted = formatDeferredText(text, spec, (int)value); break;
+			case L_FORMAT_LENGTH: isFormatted = formatDeferredText(text, spec, (long)value); break;
+			case LL_FORMAT_LENGTH: isFormatted = formatDeferredText(text, spec, (long long)value); break;
+			case J_FORMAT_LENGTH: isFormatted = formatDeferredText(text, spec, (intmax_t)value); break;
+			case Z_FORMAT_LENGTH: isFormatted = formatDeferredText(text, spec, (size_t)value); break;
+			case T_FORMAT_LENGTH: isFormatted = formatDeferredText(text, spec, (ptrdiff_t)value); break;
+			}
+			break;
+		}
+		case 'o': case 'u': case 'x': case 'X':
+		{
+			uint64_t value;
+			memcpy(&value, readDeferredValue(buffer, &offset, sizeof(uint64_t)), sizeof(uint64_t));
+			switch (length)
+			{
+			default: isFormatted = formatDeferredText(text, spec, (unsigned int)value); break;
+			case L_FORMAT_LENGTH: isFormatted = formatDeferredText(text, spec, (unsigned long)value); break;
+			case LL_FORMAT_LENGTH: isFormatted = formatDeferredText(text, spec, (unsigned long long)value); break;
+			case J_FORMAT_LENGTH: isFormatted = formatDeferredText(text, spec, (uintmax_t)value); break;
+			case Z_FORMAT_LENGTH: isFormatted = formatDeferredText(text, spec, (size_t)value); break;
+			case T_FORMAT_LENGTH: isFormatted = formatDeferredText(text, spec, (ptrdiff_t)value); break;
+			}
+			break;
+		}
+		case 'c':
+		{
+			int64_t value;
+			memcpy(&value, readDeferredValue(buffer, &offset, sizeof(int64_t)), sizeof(int64_t));
+			if (length == L_FORMAT_LENGTH)
+				isFormatted = formatDeferredText(text, spec, (wint_t)value);
+			else
+				isFormatted = formatDeferredText(text, spec, (int)value);
+			break;
+		}
+		case 'p':
+		{
+			void* value;
+			memcpy(&value, readDeferredValue(buffer, &offset, sizeof(void*)), sizeof(void*));
+			isFormatted = formatDeferredText(text, spec, value);
+			break;
+		}
+		case 's':
+		{
+			uint32_t stringLength;
+			memcpy(&stringLength, readDeferredValue(buffer, &offset, sizeof(uint32_t)), sizeof(uint32_t));
+			const char* value = "(null)";
+			if (stringLength != NULL_DEFERRED_STRING)
+				value = readDeferredValue(buffer, &offset, (stringLength + 1) * sizeof(char));
+			isFormatted = formatDeferredText(text, spec, value);
+			break;
+		}
+		default:
+			if (length == BIG_L_FORMAT_LENGTH)
+			{
+				long double value;
+				memcpy(&value, readDeferredValue(buffer, &offset, sizeof(long double)), sizeof(long double));
+				isFormatted = formatDeferredText(text, spec, value);
+			}
+			else
+			{
+				double value;
+				memcpy(&value, readDeferredValue(buffer, &offset, sizeof(double)), sizeof(double));
+				isFormatted = formatDeferredText(text, spec, value);
+			}
+			break;
+		}
+
+		if (!isFormatted)
+			return false;
+	}
+	return true;
+}
+
+//**********************************************************************************************************************
+static void writeDeferredRecord(Logger logger, const LogHeader* header, const char* category,
+	const char* context, const LogCallSite* callSite, LogLevel level, const char* fmt, ...)
+{
+	va_list args;
+	va_start(args, fmt);
+	writeLogRecordVA(logger, header, category, context, callSite, level, fmt, args);
+	va_end(args);
+}
+static void flushLogDeferral(LogDeferral* deferral)
+{
+	assert(deferral);
+
+	Logger logger = deferral->logger;
+	const uint8_t* buffer = deferral->buffer;
+	size_t size = deferral->size;
+	LogHeader header;
+	memcpy(header.threadName, deferral->threadName, 16 * sizeof(char));
+
+	for (size_t offset = 0; offset < size; offset += ((const DeferredMessage*)(buffer + offset))->size)
+	{
+		const DeferredMessage* message = (const DeferredMessage*)(buffer + offset);
+		size_t dataOffset = offset + sizeof(DeferredMessage);
+		const char* context = NULL;
+
+		if (message->contextLength > 0)
+		{
+			context = (const char*)buffer + dataOffset;
+			dataOffset += message->contextLength + 1;
+		}
+
+		const char* fmt = "%s";
+		if (!message->isFormatted)
+		{
+			fmt = (const char*)buffer + dataOffset;
+			dataOffset += strlen(fmt) + 1;
+		}
+
+		DeferredText text;
+		text.data = text.buffer;
+		text.length = 0;
+		text.capacity = DEFERRED_TEXT_BUFFER_SIZE;
+		text.buffer[0] = '\0';
+
+		if (replayDeferredMessage(fmt, buffer, dataOffset, &text))
+		{
+			setLogHeaderTime(&header, message->rawTime, message->milliseconds);
+			writeDeferredRecord(logger, &header, message->category,
+				context, message->callSite, message->level, "%s", text.data);
+		}
+
+		if (text.data != text.buffer)
+			free(text.data);
+	}
+
+	if (deferral->dropCount > 0)
+	{
+		time_t rawTime;
+		int milliseconds;
+		getLogHeaderTime(&rawTime, &milliseconds);
+		setLogHeaderTime(&header, rawTime, milliseconds);
+		writeDeferredRecord(logger, &header, NULL, NULL, NULL, WARN_LOG_LEVEL,
+			"Dropped %u deferred messages, buffer is full.", deferral->dropCount);
+	}
+
+	deferral->size = 0;
+	deferral->dropCount = 0;
+}
+static void failLogDeferralChain(LogDeferral* deferral, Logger logger)
+{
+	if (!deferral) return;
+
+	// Note: Enclosing scope messages are older, so they are written first.
+	failLogDeferralChain(deferral->previous, logger);
+
+	if (deferral->logger != logger || deferral->isFailed)
+		return;
+
+	flushLogDeferral(deferral);
+	deferral->isFailed = true;
+}
+
+//**********************************************************************************************************************
+void deferLogMessageVA(Logger logger, const char* category,
+	const LogCallSite* callSite, LogLevel level, const char* fmt, va_list args)
+{
+	assert(logger);
+	assert(fmt);
+
+	LogDeferral* deferral = threadLogDeferral;
+	while (deferral && deferral->logger != logger)
+		deferral = deferral->previous;
+
+	if (!deferral || level > deferral->level)
+		return;
+
+	const char* context = getLogContextPrefix();
+
+	if (deferral->isFailed)
+	{
+		// Note: Failed scope messages are written directly, to keep them in order with the other messages.
+		time_t rawTime;
+		int milliseconds;
+		getLogHeaderTime(&rawTime, &milliseconds);
+
+		LogHeader header;
+		setLogHeaderTime(&header, rawTime, milliseconds);
+		memcpy(header.threadName, deferral->threadName, 16 * sizeof(char));
+		writeLogRecordVA(logger, &header, category, context[0] != '\0' ? context : NULL,
+			callSite, level, fmt, args);
+		return;
+	}
+
+	if (!captureDeferredMessage(deferral, category, callSite, level, context, fmt, args))
+		deferral->dropCount++;
+}
+void failThreadLogDeferrals(Logger logger)
+{
+	assert(logger);
+	if (threadLogDeferral)
+		failLogDeferralChain(threadLogDeferral, logger);
+}
+
+//**********************************************************************************************************************
+LogyResult beginLogDeferral(Logger logger, LogLevel level, size_t bufferSize)
+{
+	assert(logger);
+	assert(level < ALL_LOG_LEVEL);
+	assert(bufferSize > 0);
+
+	LogDeferral* deferral = calloc(1, sizeof(LogDeferral));
+	if (!deferral)
+		return FAILED_TO_ALLOCATE_LOGY_RESULT;
+
+	// Note: Aligning buffer size and messages, to access message headers directly.
+	bufferSize = (bufferSize + 7) & ~(size_t)7;
+	uint8_t* buffer = malloc(bufferSize);
+	if (!buffer)
+	{
+		free(deferral);
+		return FAILED_TO_ALLOCATE_LOGY_RESULT;
+	}
+
+	deferral->previous = threadLogDeferral;
+	deferral->logger = logger;
+	deferral->buffer = buffer;
+	deferral->bufferSize = bufferSize;
+	deferral->level = level;
+	getThreadName(deferral->threadName, 16);
+	threadLogDeferral = deferral;
+	return SUCCESS_LOGY_RESULT;
+}
+void endLogDeferral()
+{
+	LogDeferral* deferral = threadLogDeferral;
+	assert(deferral); // No deferral scope!
+	threadLogDeferral = deferral->previous;
+	free(deferral->buffer);
+	free(deferral);
+}
+void failLogDeferral()
+{
+	LogDeferral* deferral = threadLogDeferral;
+	assert(deferral); // No deferral scope!
+	failLogDeferralChain(deferral, deferral->logger);
+}
+
+bool isLogDeferralActive()
+{
+	return threadLogDeferral != NULL;
+}
+bool isLogDeferralFailed()
+{
+	LogDeferral* deferral = threadLogDeferral;
+	return deferral && deferral->isFailed;
+}
@@ -0,0 +1,839 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if __linux__ && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "logy/forward.h"
+#include "internal.h"
+#include "mpio/file.h"
+
+#include <string.h>
+
+#if LOGY_FORWARD_SUPPORT
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+#define FORWARD_QUEUE_CAPACITY 16384
+#define MAX_FORWARD_BUFFER_SIZE (1024 * 1024)
+#define FORWARD_RECONNECT_DELAY 1.0
+#define FORWARD_RETRY_DELAY 0.01
+#define SYSLOG_USER_FACILITY 1
+#define MAX_SYSLOG_NAME_LENGTH 48
+
+static const uint8_t syslogSeverities[LOG_LEVEL_COUNT] =
+{
+	7, 2, 3, 4, 6, 7, 7, 7,
+};
+
+typedef enum ForwardSendResult
+{
+	SENT_FORWARD_RESULT = 0,
+	BLOCKED_FORWARD_RESULT = 1,
+	FAILED_FORWARD_RESULT = 2,
+} ForwardSendResult;
+
+struct LogForwarder
+{
+	Mutex mutex;
+	Cond cond;
+	Thread thread;
+	LogRecord** queue;
+	LogRecord** batch;
+	char* socketPath;
+	char* spoolPath;
+	FILE* spoolFile;
+	char* buffer;
+	size_t* frameEnds;
+	char* frame;
+	size_t bufferSize;
+	size_t bufferOffset;
+	size_t bufferCapacity;
+	size_t frameCount;
+	size_t frameCapacity;
+	size_t frameBufferCapacity;
+	size_t spoolLimit;
+	long spoolReadOffset;
+	long spoolWriteOffset;
+	uint64_t dropCount;
+	double reconnectTime;
+	uint32_t queueHead;
+	uint32_t queueSize;
+	int processId;
+	int socket;
+	char hostName[MAX_SYSLOG_NAME_LENGTH + 1];
+	char appName[MAX_SYSLOG_NAME_LENGTH + 1];
+	LogThreadOptions threadOptions;
+	LogForwardType type;
+	volatile uint32_t isThreadFailed;
+	bool useSyslog;
+	bool isConnected;
+	volatile bool isRunning;
+};
+
+//**********************************************************************************************************************
+static void setSyslogName(char* name, const char* value, size_t length)
+{
+	// Note: RFC 5424 header fields are printable ASCII without spaces, "-" is the nil value.
+	if (length > MAX_SYSLOG_NAME_LENGTH)
+		length = MAX_SYSLOG_NAME_LENGTH;
+	for (size_t i = 0; i < length; i++)
+		name[i] = value[i] > 32 && value[i] < 127 ? value[i] : '_';
+	if (length == 0)
+		name[length++] = '-';
+	name[length] = '\0';
+}
+static bool reserveForwardMemory(void** memory, size_t* capacity, size_t size, size_t elementSize)
+{
+	if (size <= *capacity)
+		return true;
+
+	size_t newCapacity = *capacity > 0 ? *capacity : 256;
+	while (newCapacity < size)
+		newCapacity *= 2;
+
+	void* newMemory = realloc(*memory, newCapacity * elementSize);
+	if (!newMemory) return false;
+	*memory = newMemory;
+	*capacity = newCapacity;
+	return true;
+}
+static void addForwardDrops(LogForwarder* forwarder, uint64_t count)
+{
+	lockMutex(forwarder->mutex);
+	forwarder->dropCount += count;
+	unlockMutex(forwarder->mutex);
+}
+
+//**********************************************************************************************************************
+static void resetForwardSpool(LogForwarder* forwarder)
+{
+	assert(forwarder);
+
+	if (forwarder->spoolFile)
+		closeFile(forwarder->spoolFile);
+	forwarder->spoolFile = openFile(forwarder->spoolPath, "w+b");
+	forwarder->spoolReadOffset = forwarder->spoolWriteOffset = 0;
+}
+static void writeForwardSpool(LogForwarder* forwarder, const char* data, size_t length)
+{
+	assert(forwarder);
+	assert(data);
+
+	FILE* file = forwarder->spoolFile;
+	if (!file || forwarder->spoolWriteOffset + sizeof(uint32_t) + length > forwarder->spoolLimit)
+	{
+		addForwardDrops(forwarder, 1);
+		return;
+	}
+
+	uint32_t frameLength = (uint32_t)length;
+	if (fseek(file, forwarder->spoolWriteOffset, SEEK_SET) != 0 ||
+		fwrite(&frameLength, sizeof(uint32_t), 1, file) != 1 || fwrite(data, sizeof(char), length, file) != length)
+	{
+		addForwardDrops(forwarder, 1);
+		return;
+	}
+	forwarder->spoolWriteOffset += (long)(sizeof(uint32_t) + length);
+}
+static void skipPartialForwardFrame(LogForwarder* forwarder)
+{
+	assert(forwarder);
+
+	// Note: Partially sent frame can't be resent to the new connection, skipping to the next frame.
+	size_t bufferOffset = forwarder->bufferOffset, frameBegin = 0;
+	const size_t* frameEnds = forwarder->frameEnds;
+	for (size_t i = 0; i < forwarder->frameCount && frameBegin < bufferOffset; i++)
+	{
+		if (bufferOffset < frameEnds[i])
+		{
+			forwarder->bufferOffset = frameEnds[i];
+			addForwardDrops(forwarder, 1);
+			break;
+		}
+		frameBegin = frameEnds[i];
+	}
+}
+static void spoolForwardBuffer(LogForwarder* forwarder)
+{
+	assert(forwarder);
+
+	// Note: Spooling each frame separately, so replay and drops are counted per record.
+	size_t frameBegin = forwarder->bufferOffset;
+	const size_t* frameEnds = forwarder->frameEnds;
+	for (size_t i = 0; i < forwarder->frameCount; i++)
+	{
+		if (frameEnds[i] <= frameBegin)
+			continue;
+		writeForwardSpool(forwarder, forwarder->buffer + frameBegin, frameEnds[i] - frameBegin);
+		frameBegin = frameEnds[i];
+	}
+	forwarder->bufferOffset = forwarder->bufferSize = forwarder->frameCount = 0;
+}
+static void dropForwardBuffer(LogForwarder* forwarder)
+{
+	assert(forwarder);
+
+	uint64_t dropCount = 0;
+	for (size_t i = 0; i < forwarder->frameCount; i++)
+		dropCount += forwarder->frameEnds[i] > forwarder->bufferOffset ? 1 : 0;
+	addForwardDrops(forwarder, dropCount);
+	forwarder->bufferOffset = forwarder->bufferSize = forwarder->frameCount = 0;
+}
+static void saveForwardSpool(LogForwarder* forwarder)
+{
+	assert(forwarder);
+
+	skipPartialForwardFrame(forwarder);
+	if (forwarder->bufferOffset == forwarder->bufferSize && forwarder->spoolReadOffset == 0)
+		return;
+
+	if (!forwarder->spoolFile)
+	{
+		dropForwardBuffer(forwarder);
+		return;
+	}
+
+	// Note: Rewriting the spool for the next run. Unsent buffer frames are older than the unread
+	//       spool frames, so they go first, and already replayed spool frames are not kept.
+	const char* spoolPath = forwarder->spoolPath;
+	size_t spoolPathLength = strlen(spoolPath);
+	char* newSpoolPath = malloc((spoolPathLength + 5) * sizeof(char));
+	if (!newSpoolPath)
+	{
+		dropForwardBuffer(forwarder);
+		return;
+	}
+	memcpy(newSpoolPath, spoolPath, spoolPathLength * sizeof(char));
+	memcpy(newSpoolPath + spoolPathLength, ".new", 5 * sizeof(char));
+
+	FILE* oldFile = forwarder->spoolFile;
+	long readOffset = forwarder->spoolReadOffset, writeOffset = forwarder->spoolWriteOffset;
+	forwarder->spoolFile = openFile(newSpoolPath, "w+b");
+	forwarder->spoolReadOffset = forwarder->spoolWriteOffset = 0;
+
+	if (!forwarder->spoolFile)
+	{
+		forwarder->spoolFile = oldFile;
+		forwarder->spoolReadOffset = readOffset;
+		forwarder->spoolWriteOffset = writeOffset;
+		dropForwardBuffer(forwarder);
+		free(newSpoolPath);
+		return;
+	}
+
+	spoolForwardBuffer(forwarder);
+
+	while (readOffset < writeOffset)
+	{
+		uint32_t length;
+		if (fseek(oldFile, readOffset, SEEK_SET) != 0 ||
+			fread(&length, sizeof(uint32_t), 1, oldFile) != 1 ||
+			readOffset + (long)(sizeof(uint32_t) + length) > writeOffset ||
+			!reserveForwardMemory((void**)&forwarder->frame, &forwarder->frameBufferCapacity, length, sizeof(char)) ||
+			fread(forwarder->frame, sizeof(char), length, oldFile) != length)
+		{
+			addForwardDrops(forwarder, 1);
+			break;
+		}
+
+		writeForwardSpool(forwarder, forwarder->frame, length);
+		readOffset += (long)(sizeof(uint32_t) + length);
+	}
+
+	closeFile(oldFile);
+	fflush(forwarder->spoolFile);
+	if (rename(newSpoolPath, spoolPath) != 0)
+		remove(newSpoolPath);
+	free(newSpoolPath);
+}
+
+//**********************************************************************************************************************
+static void connectForwarder(LogForwarder* forwarder)
+{
+	assert(forwarder);
+	assert(forwarder->socket < 0);
+
+	int sock = socket(AF_UNIX, forwarder->type == DATAGRAM_LOG_FORWARD_TYPE ? SOCK_DGRAM : SOCK_STREAM, 0);
+	if (sock < 0) return;
+
+	// Note: Non-blocking connect fails instead of waiting if agent listen backlog is full.
+	fcntl(sock, F_SETFD, FD_CLOEXEC);
+	fcntl(sock, F_SETFL, fcntl(sock, F_GETFL) | O_NONBLOCK);
+	#if __APPLE__
+	int noSigPipe = 1;
+	setsockopt(sock, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(int));
+	#endif
+
+	struct sockaddr_un address;
+	memset(&address, 0, sizeof(struct sockaddr_un));
+	address.sun_family = AF_UNIX;
+	memcpy(address.sun_path, forwarder->socketPath, strlen(forwarder->socketPath));
+
+	if (connect(sock, (struct sockaddr*)&address, sizeof(struct sockaddr_un)) != 0)
+	{
+		close(sock);
+		return;
+	}
+
+	forwarder->socket = sock;
+	lockMutex(forwarder->mutex);
+	forwarder->isConnected = true;
+	unlockMutex(forwarder->mutex);
+}
+static void disconnectForwarder(LogForwarder* forwarder)
+{
+	assert(forwarder);
+	assert(forwarder->socket >= 0);
+
+	close(forwarder->socket);
+	forwarder->socket = -1;
+	lockMutex(forwarder->mutex);
+	forwarder->isConnected = false;
+	unlockMutex(forwarder->mutex);
+	forwarder->reconnectTime = getCurrentClock() + FORWARD_RECONNECT_DELAY;
+
+	skipPartialForwardFrame(forwarder);
+
+	// Note: Unsent data is older than the unread spool data, so it is spooled only if spool is empty.
+	if (forwarder->bufferOffset < forwarder->bufferSize && forwarder->spoolReadOffset == forwarder->spoolWriteOffset)
+		spoolForwardBuffer(forwarder);
+}
+
+//**********************************************************************************************************************
+static ForwardSendResult sendForwardDatagram(LogForwarder* forwarder, const char* data, size_t length)
+{
+	while (true)
+	{
+		if (send(forwarder->socket, data, length, MSG_NOSIGNAL) >= 0)
+			return SENT_FORWARD_RESULT;
+		if (errno == EINTR)
+			continue;
+		if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)
+			return BLOCKED_FORWARD_RESULT;
+
+		// Note: Datagram larger than the agent socket limit can never be sent.
+		if (errno == EMSGSIZE)
+		{
+			addForwardDrops(forwarder, 1);
+			return SENT_FORWARD_RESULT;
+		}
+
+		disconnectForwarder(forwarder);
+		return FAILED_FORWARD_RESULT;
+	}
+}
+static void sendForwardBuffer(LogForwarder* forwarder)
+{
+	while (forwarder->socket >= 0 && forwarder->bufferOffset < forwarder->bufferSize)
+	{
+		ssize_t count = send(forwarder->socket, forwarder->buffer + forwarder->bufferOffset,
+			forwarder->bufferSize - forwarder->bufferOffset, MSG_NOSIGNAL);
+		if (count > 0)
+		{
+			forwarder->bufferOffset += (size_t)count;
+			continue;
+		}
+		if (count < 0 && errno == EINTR)
+			continue;
+		if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+			return;
+		disconnectForwarder(forwarder);
+	}
+
+	if (forwarder->bufferOffset == forwarder->bufferSize)
+		forwarder->bufferOffset = forwarder->bufferSize = forwarder->frameCount = 0;
+}
+static bool appendForwardBuffer(LogForwarder* forwarder, const char* data, size_t length)
+{
+	// Note: Moving unsent data to the buffer start, so it does not grow while agent is slow.
+	size_t bufferOffset = forwarder->bufferOffset;
+	if (bufferOffset > 0)
+	{
+		size_t* frameEnds = forwarder->frameEnds;
+		size_t frameCount = 0;
+		for (size_t i = 0; i < forwarder->frameCount; i++)
+		{
+			if (frameEnds[i] > bufferOffset)
+				frameEnds[frameCount++] = frameEnds[i] - bufferOffset;
+		}
+
+		forwarder->bufferSize -= bufferOffset;
+		memmove(forwarder->buffer, forwarder->buffer + bufferOffset, forwarder->bufferSize);
+		forwarder->bufferOffset = 0;
+		forwarder->frameCount = frameCount;
+	}
+
+	if (!reserveForwardMemory((void**)&forwarder->buffer,
+			&forwarder->bufferCapacity, forwarder->bufferSize + length, sizeof(char)) ||
+		!reserveForwardMemory((void**)&forwarder->frameEnds,
+			&forwarder->frameCapacity, forwarder->frameCount + 1, sizeof(size_t)))
+	{
+		return false;
+	}
+
+	memcpy(forwarder->buffer + forwarder->bufferSize, data, length);
+	forwarder->bufferSize += length;
+	forwarder->frameEnds[forwarder->frameCount++] = forwarder->bufferSize;
+	return true;
+}
+
+//**********************************************************************************************************************
+static void replayForwardSpool(LogForwarder* forwarder)
+{
+	assert(forwarder);
+
+	FILE* file = forwarder->spoolFile;
+	while (forwarder->socket >= 0 && forwarder->spoolReadOffset < forwarder->spoolWriteOffset)
+	{
+		if (forwarder->type == STREAM_LOG_FORWARD_TYPE)
+		{
+			sendForwardBuffer(forwarder);
+			if (forwarder->bufferSize > 0)
+				return;
+		}
+
+		// Note: Discarding the spool if it has a partial frame, for example, after the crash.
+		uint32_t length;
+		if (fseek(file, forwarder->spoolReadOffset, SEEK_SET) != 0 ||
+			fread(&length, sizeof(uint32_t), 1, file) != 1 ||
+			forwarder->spoolReadOffset + (long)(sizeof(uint32_t) + length) > forwarder->spoolWriteOffset ||
+			!reserveForwardMemory((void**)&forwarder->frame, &forwarder->frameBufferCapacity, length, sizeof(char)) ||
+			fread(forwarder->frame, sizeof(char), length, file) != length)
+		{
+			addForwardDrops(forwarder, 1);
+			resetForwardSpool(forwarder);
+			return;
+		}
+
+		if (forwarder->type == DATAGRAM_LOG_FORWARD_TYPE)
+		{
+			if (sendForwardDatagram(forwarder, forwarder->frame, length) != SENT_FORWARD_RESULT)
+				return;
+		}
+		else
+		{
+			if (!appendForwardBuffer(forwarder, forwarder->frame, length))
+				return;
+		}
+		forwarder->spoolReadOffset += (long)(sizeof(uint32_t) + length);
+	}
+
+	if (forwarder->type == STREAM_LOG_FORWARD_TYPE)
+		sendForwardBuffer(forwarder);
+	if (forwarder->spoolWriteOffset > 0 && forwarder->spoolReadOffset == forwarder->spoolWriteOffset)
+		resetForwardSpool(forwarder);
+}
+
+//**********************************************************************************************************************
+static const char* formatForwardFrame(LogForwarder* forwarder, const LogRecord* record, size_t* length)
+{
+	assert(forwarder);
+	assert(record);
+	assert(length);
+
+	const char* data = record->data;
+	size_t dataLength = record->length;
+
+	if (!forwarder->useSyslog)
+	{
+		// Note: Datagram is the message boundary, new line is not needed.
+		if (forwarder->type == DATAGRAM_LOG_FORWARD_TYPE && dataLength > 0 && data[dataLength - 1] == '\n')
+			dataLength--;
+		*length = dataLength;
+		return data;
+	}
+
+	// Note: Syslog header has its own timestamp, skipping the record time part.
+	const char* message = strstr(data, "] ");
+	message = message ? message + 2 : data;
+	size_t messageLength = dataLength - (size_t)(message - data);
+	if (messageLength > 0 && message[messageLength - 1] == '\n')
+		messageLength--;
+
+	time_t rawTime = (time_t)record->time;
+	int milliseconds = (int)((record->time - (double)rawTime) * 1000.0 + 0.5);
+	if (milliseconds > 999) milliseconds = 999;
+	struct tm timeInfo;
+	gmtime_r(&rawTime, &timeInfo);
+
+	char header[192];
+	int headerLength = snprintf(header, sizeof(header),
+		"<%u>1 %d-%02d-%02dT%02d:%02d:%02d.%03dZ %s %s %d - - ",
+		SYSLOG_USER_FACILITY * 8u + syslogSeverities[record->level],
+		timeInfo.tm_year + 1900, timeInfo.tm_mon + 1, timeInfo.tm_mday, timeInfo.tm_hour,
+		timeInfo.tm_min, timeInfo.tm_sec, milliseconds, forwarder->hostName,
+		forwarder->appName, forwarder->processId);
+	if (headerLength <= 0 || headerLength >= (int)sizeof(header))
+		return NULL;
+
+	// Note: Stream socket messages use octet counting framing (RFC 6587).
+	char prefix[24];
+	int prefixLength = 0;
+	if (forwarder->type == STREAM_LOG_FORWARD_TYPE)
+		prefixLength = snprintf(prefix, sizeof(prefix), "%zu ", (size_t)headerLength + messageLength);
+
+	size_t frameLength = (size_t)prefixLength + headerLength + messageLength;
+	if (!reserveForwardMemory((void**)&forwarder->frame, &forwarder->frameBufferCapacity, frameLength, sizeof(char)))
+		return NULL;
+
+	char* frame = forwarder->frame;
+	memcpy(frame, prefix, prefixLength);
+	memcpy(frame + prefixLength, header, headerLength);
+	memcpy(frame + prefixLength + headerLength, message, messageLength);
+	*length = frameLength;
+	return frame;
+}
+static void forwardLogRecord(LogForwarder* forwarder, const LogRecord* record)
+{
+	assert(forwarder);
+	assert(record);
+
+	size_t length;
+	const char* frame = formatForwardFrame(forwarder, record, &length);
+	if (!frame)
+	{
+		addForwardDrops(forwarder, 1);
+		return;
+	}
+
+	// Note: Records are sent directly only if there is no older spooled data, to keep the order.
+	if (forwarder->socket >= 0 && forwarder->spoolReadOffset == forwarder->spoolWriteOffset)
+	{
+		if (forwarder->type == DATAGRAM_LOG_FORWARD_TYPE)
+		{
+			if (sendForwardDatagram(forwarder, frame, length) == SENT_FORWARD_RESULT)
+				return;
+		}
+		else if (forwarder->bufferSize - forwarder->bufferOffset < MAX_FORWARD_BUFFER_SIZE)
+		{
+			if (appendForwardBuffer(forwarder, frame, length))
+				return;
+		}
+	}
+
+	writeForwardSpool(forwarder, frame, length);
+}
+
+//**********************************************************************************************************************
+static void onForwarderUpdate(void* argument)
+{
+	assert(argument);
+	setThreadName("LOG-FWD");
+
+	LogForwarder* forwarder = (LogForwarder*)argument;
+	if (!applyLogThreadOptions(&forwarder->threadOptions))
+		logyAtomicStore32(&forwarder->isThreadFailed, 1);
+
+	Mutex mutex = forwarder->mutex;
+	LogRecord** queue = forwarder->queue;
+	LogRecord** batch = forwarder->batch;
+
+	lockMutex(mutex);
+	while (true)
+	{
+		if (forwarder->queueSize == 0 && forwarder->isRunning)
+		{
+			bool hasBacklog = forwarder->bufferSize > 0 || forwarder->spoolReadOffset < forwarder->spoolWriteOffset;
+			double delay = hasBacklog && forwarder->socket >= 0 ? FORWARD_RETRY_DELAY : FORWARD_RECONNECT_DELAY;
+			waitCondFor(forwarder->cond, mutex, (int64_t)(delay * 1000000000.0));
+		}
+
+		uint32_t queueHead = forwarder->queueHead, batchSize = forwarder->queueSize;
+		for (uint32_t i = 0; i < batchSize; i++)
+			batch[i] = queue[(queueHead + i) & (FORWARD_QUEUE_CAPACITY - 1)];
+		forwarder->queueHead = (queueHead + batchSize) & (FORWARD_QUEUE_CAPACITY - 1);
+		forwarder->queueSize = 0;
+		bool isRunning = forwarder->isRunning;
+		unlockMutex(mutex);
+
+		if (forwarder->socket < 0 && getCurrentClock() >= forwarder->reconnectTime)
+			connectForwarder(forwarder);
+		if (forwarder->socket >= 0)
+			replayForwardSpool(forwarder);
+
+		for (uint32_t i = 0; i < batchSize; i++)
+		{
+			forwardLogRecord(forwarder, batch[i]);
+			releaseLogRecord(batch[i]);
+		}
+
+		if (forwarder->type == STREAM_LOG_FORWARD_TYPE)
+			sendForwardBuffer(forwarder);
+		if (forwarder->spoolFile)
+			fflush(forwarder->spoolFile);
+
+		lockMutex(mutex);
+		if (!isRunning && forwarder->queueSize == 0)
+			break;
+	}
+	unlockMutex(mutex);
+
+	// Note: Keeping unsent records in the spool for the next run.
+	saveForwardSpool(forwarder);
+}
+
+//**********************************************************************************************************************
+LogForwarder* createLogForwarder(const char* directoryPath, const char* socketPath, LogForwardType type,
+	bool useSyslog, size_t spoolLimit, const LogThreadOptions* threadOptions)
+{
+	assert(directoryPath);
+	assert(socketPath);
+	assert(type < LOG_FORWARD_TYPE_COUNT);
+	assert(threadOptions);
+
+	size_t socketPathLength = strlen(socketPath);
+	if (socketPathLength == 0 || socketPathLength >= sizeof(((struct sockaddr_un*)NULL)->sun_path))
+		return NULL;
+
+	LogForwarder* forwarder = calloc(1, sizeof(LogForwarder));
+	if (!forwarder) return NULL;
+
+	forwarder->spoolLimit = spoolLimit;
+	forwarder->threadOptions = *threadOptions;
+	forwarder->processId = (int)getpid();
+	forwarder->socket = -1;
+	forwarder->type = type;
+	forwarder->useSyslog = useSyslog;
+	forwarder->isRunning = true;
+
+	char hostName[256];
+	if (gethostname(hostName, sizeof(hostName)) != 0)
+		hostName[0] = '\0';
+	hostName[sizeof(hostName) - 1] = '\0';
+	setSyslogName(forwarder->hostName, hostName, strlen(hostName));
+
+	// Note: Logs directory name is usually the application name.
+	const char* appName = directoryPath;
+	for (const char* c = directoryPath; *c; c++)
+	{
+		if (*c == '/' || *c == '\\')
+			appName = c + 1;
+	}
+	setSyslogName(forwarder->appName, appName, strlen(appName));
+
+	char* path = malloc((socketPathLength + 1) * sizeof(char));
+	if (!path)
+	{
+		destroyLogForwarder(forwarder);
+		return NULL;
+	}
+	memcpy(path, socketPath, (socketPathLength + 1) * sizeof(char));
+	forwarder->socketPath = path;
+
+	LogRecord** queue = malloc(FORWARD_QUEUE_CAPACITY * sizeof(LogRecord*));
+	if (!queue)
+	{
+		destroyLogForwarder(forwarder);
+		return NULL;
+	}
+	forwarder->queue = queue;
+
+	LogRecord** batch = malloc(FORWARD_QUEUE_CAPACITY * sizeof(LogRecord*));
+	if (!batch)
+	{
+		destroyLogForwarder(forwarder);
+		return NULL;
+	}
+	forwarder->batch = batch;
+
+	if (spoolLimit > 0)
+	{
+		size_t directoryPathLength = strlen(directoryPath);
+		size_t fileNameLength = strlen(LOG_FORWARD_SPOOL_FILE_NAME);
+		char* spoolPath = malloc((directoryPathLength + fileNameLength + 2) * sizeof(char));
+		if (!spoolPath)
+		{
+			destroyLogForwarder(forwarder);
+			return NULL;
+		}
+
+		memcpy(spoolPath, directoryPath, directoryPathLength * sizeof(char));
+		spoolPath[directoryPathLength] = '/';
+		memcpy(spoolPath + directoryPathLength + 1, LOG_FORWARD_SPOOL_FILE_NAME, (fileNameLength + 1) * sizeof(char));
+		forwarder->spoolPath = spoolPath;
+
+		// Note: Replaying records spooled by the previous run.
+		FILE* spoolFile = openFile(spoolPath, "r+b");
+		if (spoolFile)
+		{
+			forwarder->spoolFile = spoolFile;
+			if (fseek(spoolFile, 0, SEEK_END) == 0)
+				forwarder->spoolWriteOffset = ftell(spoolFile);
+			if (forwarder->spoolWriteOffset <= 0)
+				forwarder->spoolWriteOffset = 0;
+		}
+		else
+		{
+			resetForwardSpool(forwarder);
+			if (!forwarder->spoolFile)
+			{
+				destroyLogForwarder(forwarder);
+				return NULL;
+			}
+		}
+	}
+
+	Mutex mutex = createMutex();
+	if (!mutex)
+	{
+		destroyLogForwarder(forwarder);
+		return NULL;
+	}
+	forwarder->mutex = mutex;
+
+	Cond cond = createCond();
+	if (!cond)
+	{
+		destroyLogForwarder(forwarder);
+		return NULL;
+	}
+	forwarder->cond = cond;
+
+	connectForwarder(forwarder);
+
+	Thread thread = createThread(onForwarderUpdate, forwarder);
+	if (!thread)
+	{
+		destroyLogForwarder(forwarder);
+		return NULL;
+	}
+	forwarder->thread = thread;
+	return forwarder;
+}
+void destroyLogForwarder(LogForwarder* forwarder)
+{
+	if (!forwarder) return;
+
+	if (forwarder->thread)
+	{
+		lockMutex(forwarder->mutex);
+		forwarder->isRunning = false;
+		signalCond(forwarder->cond);
+		unlockMutex(forwarder->mutex);
+		joinThread(forwarder->thread);
+		destroyThread(forwarder->thread);
+	}
+
+	if (forwarder->socket >= 0)
+		close(forwarder->socket);
+	if (forwarder->spoolFile)
+		closeFile(forwarder->spoolFile);
+
+	destroyCond(forwarder->cond);
+	destroyMutex(forwarder->mutex);
+	free(forwarder->frame);
+	free(forwarder->frameEnds);
+	free(forwarder->buffer);
+	free(forwarder->spoolPath);
+	free(forwarder->socketPath);
+	free(forwarder->batch);
+	free(forwarder->queue);
+	free(forwarder);
+}
+void pushLogForwarder(LogForwarder* forwarder, LogRecord* record)
+{
+	assert(forwarder);
+	assert(record);
+
+	Mutex mutex = forwarder->mutex;
+	lockMutex(mutex);
+
+	// Note: Dropping record instead of blocking the caller, if forwarding thread can't keep up.
+	uint32_t queueSize = forwarder->queueSize;
+	if (queueSize == FORWARD_QUEUE_CAPACITY)
+	{
+		forwarder->dropCount++;
+		unlockMutex(mutex);
+		return;
+	}
+
+	retainLogRecord(record);
+	forwarder->queue[(forwarder->queueHead + queueSize) & (FORWARD_QUEUE_CAPACITY - 1)] = record;
+	forwarder->queueSize = queueSize + 1;
+	if (queueSize == 0)
+		signalCond(forwarder->cond);
+	unlockMutex(mutex);
+}
+bool takeLogForwarderThreadFailure(LogForwarder* forwarder)
+{
+	assert(forwarder);
+	return logyAtomicLoad32(&forwarder->isThreadFailed) != 0 &&
+		logyAtomicExchange32(&forwarder->isThreadFailed, 0) != 0;
+}
+
+//**********************************************************************************************************************
+bool isLoggerForwardConnected(Logger logger)
+{
+	assert(logger);
+
+	LogForwarder* forwarder = logger->forwarder;
+	if (!forwarder) return false;
+
+	lockMutex(forwarder->mutex);
+	bool isConnected = forwarder->isConnected;
+	unlockMutex(forwarder->mutex);
+	return isConnected;
+}
+uint64_t getLoggerForwardDropCount(Logger logger)
+{
+	assert(logger);
+
+	LogForwarder* forwarder = logger->forwarder;
+	if (!forwarder) return 0;
+
+	lockMutex(forwarder->mutex);
+	uint64_t dropCount = forwarder->dropCount;
+	unlockMutex(forwarder->mutex);
+	return dropCount;
+}
+
+#else
+
+// Note: Logger does not create forwarder on the unsupported platforms.
+LogForwarder* createLogForwarder(const char* directoryPath, const char* socketPath, LogForwardType type,
+	bool useSyslog, size_t spoolLimit, const LogThreadOptions* threadOptions)
+{
+	return NULL;
+}
+void destroyLogForwarder(LogForwarder* forwarder) { }
+void pushLogForwarder(LogForwarder* forwarder, LogRecord* record) { }
+bool takeLogForwarderThreadFailure(LogForwarder* forwarder) { return false; }
+
+bool isLoggerForwardConnected(Logger logger)
+{
+	assert(logger);
+	return false;
+}
+uint64_t getLoggerForwardDropCount(Logger logger)
+{
+	assert(logger);
+	return 0;
+}
+
+#endif
+
+bool isLoggerForwarding(Logger logger)
+{
+	assert(logger);
+	return logger->forwarder != NULL;
+}
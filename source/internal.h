@@ -0,0 +1,297 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Note: Internal library structures, not a part of the public API.
+
+#pragma once
+#include "logy/logger.h"
+#include "logy/callsite.h"
+#include "logy/context.h"
+#include "logy/deferred.h"
+#include "mpmt/sync.h"
+#include "mpmt/thread.h"
+
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define logyAtomicLoad32(address) _InterlockedOr((volatile long*)(address), 0)
+#define logyAtomicStore32(address, value) _InterlockedExchange((volatile long*)(address), (long)(value))
+#define logyAtomicFetchAdd32(address, value) _InterlockedExchangeAdd((volatile long*)(address), (long)(value))
+#define logyAtomicExchange32(address, value) _InterlockedExchange((volatile long*)(address), (long)(value))
+#define logyAtomicLoad64(address) _InterlockedOr64((volatile long long*)(address), 0)
+#define logyAtomicStore64(address, value) _InterlockedExchange64((volatile long long*)(address), (long long)(value))
+#define logyAtomicFetchAdd64(address, value) _InterlockedExchangeAdd64((volatile long long*)(address), (long long)(value))
+#define logyAtomicLoadPointer(address) _InterlockedCompareExchangePointer((void* volatile*)(address), NULL, NULL)
+#define logyAtomicExchangePointer(address, value) _InterlockedExchangePointer((void* volatile*)(address), (value))
+#define logyAtomicStoreRelaxed32(address, value) __iso_volatile_store32((volatile __int32*)(address), (__int32)(value))
+#define logyAtomicStoreRelaxed64(address, value) __iso_volatile_store64((volatile __int64*)(address), (__int64)(value))
+#if defined(_M_ARM64)
+#define logyAtomicStoreRelease32(address, value) __stlr32((volatile unsigned __int32*)(address), (unsigned __int32)(value))
+#else
+#define logyAtomicStoreRelease32(address, value) \
+	(_ReadWriteBarrier(), __iso_volatile_store32((volatile __int32*)(address), (__int32)(value)))
+#endif
+#else
+#define logyAtomicLoad32(address) __atomic_load_n(address, __ATOMIC_SEQ_CST)
+#define logyAtomicStore32(address, value) __atomic_store_n(address, value, __ATOMIC_SEQ_CST)
+#define logyAtomicFetchAdd32(address, value) __atomic_fetch_add(address, value, __ATOMIC_SEQ_CST)
+#define logyAtomicExchange32(address, value) __atomic_exchange_n(address, value, __ATOMIC_SEQ_CST)
+#define logyAtomicLoad64(address) __atomic_load_n(address, __ATOMIC_SEQ_CST)
+#define logyAtomicStore64(address, value) __atomic_store_n(address, value, __ATOMIC_SEQ_CST)
+#define logyAtomicFetchAdd64(address, value) __atomic_fetch_add(address, value, __ATOMIC_SEQ_CST)
+#define logyAtomicLoadPointer(address) __atomic_load_n(address, __ATOMIC_SEQ_CST)
+#define logyAtomicExchangePointer(address, value) __atomic_exchange_n(address, value, __ATOMIC_SEQ_CST)
+#define logyAtomicStoreRelaxed32(address, value) __atomic_store_n(address, value, __ATOMIC_RELAXED)
+#define logyAtomicStoreRelaxed64(address, value) __atomic_store_n(address, value, __ATOMIC_RELAXED)
+#define logyAtomicStoreRelease32(address, value) __atomic_store_n(address, value, __ATOMIC_RELEASE)
+#endif
+
+#if __linux__ || __APPLE__
+#define LOGY_FORWARD_SUPPORT 1
+#else
+#define LOGY_FORWARD_SUPPORT 0
+#endif
+
+#if defined(_MSC_VER)
+#define LOGY_THREAD_LOCAL __declspec(thread)
+#else
+#define LOGY_THREAD_LOCAL __thread
+#endif
+
+#define LOG_THREAD_CACHE_SIZE 8
+
+typedef struct LogThreadToken
+{
+	volatile uint32_t refCount;
+	volatile uint32_t isExited;
+} LogThreadToken;
+
+// Note: Per-thread state of the logger components, for example thread metrics counters or span buffer,
+//       starts with this node. Owner reclaims node of the exited thread on its next background update.
+typedef struct LogThreadNode
+{
+	struct LogThreadNode* next;
+	LogThreadToken* token;
+} LogThreadNode;
+
+typedef struct LogThreadEntry
+{
+	LogThreadNode* node;
+	uint32_t ownerId;
+} LogThreadEntry;
+
+typedef LogThreadNode* (*CreateLogThreadNode)(void* owner);
+
+extern LOGY_THREAD_LOCAL LogThreadEntry logThreadCache[LOG_THREAD_CACHE_SIZE];
+
+typedef struct LogHeader
+{
+	time_t rawTime;
+	struct tm timeInfo;
+	int milliseconds;
+	char threadName[16];
+} LogHeader;
+
+typedef struct LogRecord
+{
+	struct LogRecord* next;
+	struct LogRecord* retiredNext;
+	uint64_t sequence;
+	double time;
+	volatile uint32_t refCount;
+	uint32_t length;
+	uint32_t messageOffset;
+	uint32_t callSiteId;
+	LogLevel level;
+	char threadName[16];
+	char data[];
+} LogRecord;
+
+typedef struct LogRing
+{
+	LogRecord* volatile* records;
+	LogRecord* retiredRecords[2];
+	size_t memoryLimit;
+	size_t memorySize;
+	uint64_t sequence;
+	uint32_t capacity;
+	uint32_t index;
+	uint32_t count;
+	volatile uint32_t readerCounts[2];
+	volatile uint32_t epoch;
+} LogRing;
+
+typedef struct LogTracer LogTracer;
+typedef struct LogMetrics LogMetrics;
+typedef struct LogForwarder LogForwarder;
+typedef struct LogShedder LogShedder;
+
+typedef struct LogWriter_T LogWriter_T;
+typedef LogWriter_T* LogWriter;
+
+struct Logger_T
+{
+	char* directoryPath;
+	char* filePath;
+	Mutex mutex;
+	Mutex updateMutex;
+	Cond updateCond;
+	Mutex backendMutex;
+	LogWriter writer;
+	Thread rotationThread;
+	LogBackend backend;
+	LogRecord* recordHead;
+	LogRecord* recordTail;
+	LogRing* ring;
+	LogTracer* tracer;
+	LogMetrics* metrics;
+	LogForwarder* forwarder;
+	LogShedder* shedder;
+	LogThreadOptions threadOptions;
+	struct LogCategory_T** categories;
+	size_t categoryCount;
+	size_t categoryCapacity;
+	double rotationTime;
+	double rotationDelay;
+	uint64_t backendDropCount;
+	volatile uint64_t writeFailCount;
+	uint32_t backendQueueCapacity;
+	uint32_t backendRefCount;
+	volatile uint32_t level;
+	volatile uint32_t shedLevel;
+	volatile uint32_t recordCount;
+	LogWriterType writerType;
+	bool logToStdout;
+	volatile bool isRunning;
+};
+
+//**********************************************************************************************************************
+inline static void retainLogRecord(LogRecord* record)
+{
+	assert(record);
+	logyAtomicFetchAdd32(&record->refCount, 1);
+}
+inline static void releaseLogRecord(LogRecord* record)
+{
+	assert(record);
+	if (logyAtomicFetchAdd32(&record->refCount, -1) == 1)
+		free(record);
+}
+
+inline static void lockLogSpin(volatile uint32_t* lock)
+{
+	assert(lock);
+	while (logyAtomicExchange32(lock, 1) != 0) { }
+}
+inline static void unlockLogSpin(volatile uint32_t* lock)
+{
+	assert(lock);
+	logyAtomicStore32(lock, 0);
+}
+
+uint32_t createLogThreadOwnerId();
+void watchLogThreadExit();
+LogThreadNode* findLogThreadNode(uint32_t ownerId, Mutex mutex,
+	LogThreadNode** nodes, CreateLogThreadNode createNode, void* owner);
+void releaseLogThreadToken(LogThreadToken* token);
+
+inline static LogThreadNode* getLogThreadNode(uint32_t ownerId, Mutex mutex,
+	LogThreadNode** nodes, CreateLogThreadNode createNode, void* owner)
+{
+	// Note: Thread usually writes to the same logger, so the first cache entry is checked inline.
+	LogThreadEntry* cache = logThreadCache;
+	if (cache->ownerId == ownerId)
+		return cache->node;
+	return findLogThreadNode(ownerId, mutex, nodes, createNode, owner);
+}
+inline static bool isLogThreadExited(const LogThreadNode* node)
+{
+	assert(node);
+	return node->token && logyAtomicLoad32(&node->token->isExited) != 0;
+}
+
+bool applyLogThreadOptions(const LogThreadOptions* options);
+
+char* createLogFilePathExt(const char* directoryPath, const char* name, const char* extension, bool useRotation);
+char* createLogFilePath(const char* directoryPath, bool useRotation);
+bool compressLogFile(Logger logger, const char* filePath);
+char* rotateLogFile(Logger logger, bool* isClosed);
+
+LogWriter createLogWriter(LogWriterType type, const char* filePath, bool append);
+bool destroyLogWriter(LogWriter writer);
+LogWriterType getLogWriterType(LogWriter writer);
+uint32_t writeLogData(LogWriter writer, const char* data, size_t length);
+uint32_t writeLogRecords(LogWriter writer, LogRecord* records);
+void getLogHeaderTime(time_t* rawTime, int* milliseconds);
+void setLogHeaderTime(LogHeader* header, time_t rawTime, int milliseconds);
+void writeLogRecordVA(Logger logger, const LogHeader* header, const char* category, const char* context,
+	const LogCallSite* callSite, LogLevel level, const char* fmt, va_list args);
+void writeLogMessageVA(Logger logger, const char* category,
+	const LogCallSite* callSite, LogLevel level, const char* fmt, va_list args);
+bool tryWriteLogMessageVA(Logger logger, LogLevel level, const char* fmt, va_list args);
+
+bool attachLogBackend(LogBackend backend, Logger logger);
+void detachLogBackend(LogBackend backend, Logger logger);
+void wakeLogBackend(LogBackend backend);
+void flushLogBackend(LogBackend backend, Logger logger);
+
+LogRing* createLogRing(uint32_t capacity, size_t memoryLimit);
+void destroyLogRing(LogRing* ring);
+void pushLogRing(LogRing* ring, LogRecord* record);
+
+LogTracer* createLogTracer(const char* directoryPath, uint32_t bufferCapacity, bool useRotation);
+void destroyLogTracer(LogTracer* tracer);
+bool rotateLogTracer(LogTracer* tracer, const char* directoryPath, char** oldFilePath);
+void flushLogTracer(LogTracer* tracer);
+void writeLogJsonString(FILE* file, const char* string);
+
+LogMetrics* createLogMetrics(const char* directoryPath, LogMetricsFormat format, double interval);
+void destroyLogMetrics(LogMetrics* metrics);
+void writeLogMetrics(LogMetrics* metrics);
+double updateLogMetrics(LogMetrics* metrics, double currentTime);
+void countLogMessage(LogMetrics* metrics, LogLevel level, uint32_t callSiteId);
+
+LogForwarder* createLogForwarder(const char* directoryPath, const char* socketPath, LogForwardType type,
+	bool useSyslog, size_t spoolLimit, const LogThreadOptions* threadOptions);
+void destroyLogForwarder(LogForwarder* forwarder);
+void pushLogForwarder(LogForwarder* forwarder, LogRecord* record);
+bool takeLogForwarderThreadFailure(LogForwarder* forwarder);
+
+LogShedder* createLogShedder(double latencyThreshold, uint32_t backlogThreshold,
+	double recoveryTime, LogLevel minLevel);
+void destroyLogShedder(LogShedder* shedder);
+double beginLogShedWrite(LogShedder* shedder);
+void endLogShedWrite(LogShedder* shedder, double beginTime);
+void checkLogShedBacklog(Logger logger, uint32_t backlog);
+void countShedLogMessage(Logger logger);
+double updateLogShedding(Logger logger, double currentTime);
+
+inline static bool isLogMessageShed(Logger logger, LogLevel level)
+{
+	assert(logger);
+	if (level <= logyAtomicLoad32(&logger->shedLevel))
+		return false;
+	countShedLogMessage(logger);
+	return true;
+}
+
+void deferLogMessageVA(Logger logger, const char* category,
+	const LogCallSite* callSite, LogLevel level, const char* fmt, va_list args);
+void failThreadLogDeferrals(Logger logger);
+
+void updateLogCategoryLevels(Logger logger);
+void destroyLogCategories(Logger logger);
@@ -12,12 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include "logy/logger.h"
+#include "internal.h"
 #include "mpio/os.h"
-#include "mpio/file.h"
 #include "mpio/directory.h"
-#include "mpmt/sync.h"
-#include "mpmt/thread.h"
 
 #include <time.h>
 #include <math.h>
@@ -34,26 +31,18 @@
 
 // TODO: use ENABLE_VIRTUAL_TERMINAL_PROCESSING on windows
 
-struct Logger_T
-{
-	char* directoryPath;
-	char* filePath;
-	Mutex mutex;
-	FILE* logFile;
-	Thread rotationThread;
-	double rotationTime;
-	LogLevel level;
-	bool logToStdout;
-};
+#define LOG_RECORD_BUFFER_SIZE 1024
+#define MAX_LOGGER_WAIT_TIME 1.0
 
 //**********************************************************************************************************************
-inline static char* createLogFilePath(const char* directoryPath, bool useRotation)
+char* createLogFilePathExt(const char* directoryPath, const char* name, const char* extension, bool useRotation)
 {
 	assert(directoryPath);
+	assert(name);
+	assert(extension);
 
-	const char* fileName;
 	int fileNameLength;
-	char nameBuffer[32];
+	char fileName[64];
 
 	if (useRotation)
 	{
@@ -69,19 +58,17 @@ inline static char* createLogFilePath(const char* directoryPath, bool useRotatio
 		#error Unknown operating system
 		#endif
 
-		fileNameLength = snprintf(nameBuffer, 32,
-			"log_%d-%02d-%02d_%02d-%02d-%02d.txt",
+		fileNameLength = snprintf(fileName, 64,
+			"%s_%d-%02d-%02d_%02d-%02d-%02d.%s", name,
 			timeInfo.tm_year + 1900, timeInfo.tm_mon + 1,
 			timeInfo.tm_mday, timeInfo.tm_hour,
-			timeInfo.tm_min, timeInfo.tm_sec);
-		if (fileNameLength <= 0) return NULL;
-		fileName = nameBuffer;
+			timeInfo.tm_min, timeInfo.tm_sec, extension);
 	}
 	else
 	{
-		fileName = SOLO_LOG_FILE_NAME;
-		fileNameLength = 7;
+		fileNameLength = snprintf(fileName, 64, "%s.%s", name, extension);
 	}
+	if (fileNameLength <= 0 || fileNameLength >= 64) return NULL;
 
 	size_t directoryPathLength = strlen(directoryPath);
 
@@ -94,9 +81,13 @@ inline static char* createLogFilePath(const char* directoryPath, bool useRotatio
 	filePath[directoryPathLength + 1 + fileNameLength] = '\0';
 	return filePath;
 }
-inline static void compressLogFile(Logger logger, const char* filePath)
+char* createLogFilePath(const char* directoryPath, bool useRotation)
+{
+	// Note: Solo file name is the SOLO_LOG_FILE_NAME.
+	return createLogFilePathExt(directoryPath, "log", "txt", useRotation);
+}
+bool compressLogFile(Logger logger, const char* filePath)
 {
-	assert(logger);
 	assert(filePath);
 
 	size_t filePathLength = strlen(filePath);
@@ -105,8 +96,8 @@ inline static void compressLogFile(Logger logger, const char* filePath)
 
 	if (!buffer)
 	{
-		logMessage(logger, ERROR_LOG_LEVEL, "Failed to allocate a log file zip string.");
-		return;
+		if (logger) logMessage(logger, ERROR_LOG_LEVEL, "Failed to allocate a log file zip string.");
+		return false;
 	}
 
 	int count = snprintf(buffer, bufferSize, "tar -czf %.*s.tar.gz %.*s",
@@ -114,9 +105,9 @@ inline static void compressLogFile(Logger logger, const char* filePath)
 
 	if (count <= 0)
 	{
-		logMessage(logger, ERROR_LOG_LEVEL, "Failed to write log file zip string.");
+		if (logger) logMessage(logger, ERROR_LOG_LEVEL, "Failed to write log file zip string.");
 		free(buffer);
-		return;
+		return false;
 	}
 
 	int result = system(buffer);
@@ -124,11 +115,33 @@ inline static void compressLogFile(Logger logger, const char* filePath)
 
 	if (result != 0)
 	{
-		logMessage(logger, ERROR_LOG_LEVEL, "Failed to zip log file.");
-		return;
+		if (logger) logMessage(logger, ERROR_LOG_LEVEL, "Failed to zip log file.");
+		return false;
 	}
 
 	remove(filePath);
+	return true;
+}
+char* rotateLogFile(Logger logger, bool* isClosed)
+{
+	assert(logger);
+	assert(isClosed);
+
+	char* newFilePath = createLogFilePath(logger->directoryPath, true);
+	if (!newFilePath) return NULL;
+
+	LogWriter newWriter = createLogWriter(logger->writerType, newFilePath, true);
+	if (!newWriter)
+	{
+		free(newFilePath);
+		return NULL;
+	}
+
+	char* oldFilePath = logger->filePath;
+	logger->filePath = newFilePath;
+	*isClosed = destroyLogWriter(logger->writer);
+	logger->writer = newWriter;
+	return oldFilePath;
 }
 
 //**********************************************************************************************************************
@@ -138,59 +151,99 @@ static void onRotationUpdate(void* argument)
 	setThreadName("LOG");
 
 	Logger logger = (Logger)argument;
+	if (!applyLogThreadOptions(&logger->threadOptions))
+		logMessage(logger, WARN_LOG_LEVEL, "Failed to apply logger thread options.");
+
 	Mutex mutex = logger->mutex;
-	const char* directoryPath = logger->directoryPath;
-	double timeDelay = getCurrentClock() + logger->rotationTime;
+	Mutex updateMutex = logger->updateMutex;
+	Cond updateCond = logger->updateCond;
+	double rotationTime = logger->rotationTime;
+	double timeDelay = getCurrentClock() + rotationTime;
 
-	while (logger->rotationTime > 0.0)
+	while (true)
 	{
 		double currentTime = getCurrentClock();
+		double nextTime = currentTime + MAX_LOGGER_WAIT_TIME;
 
-		if (currentTime > timeDelay)
+		if (rotationTime > 0.0 && currentTime >= timeDelay)
 		{
+			bool isClosed = true;
 			lockMutex(mutex);
+			char* oldFilePath = rotateLogFile(logger, &isClosed);
+			timeDelay = currentTime + rotationTime;
+			unlockMutex(mutex);
 
-			char* newFilePath = createLogFilePath(directoryPath, true);
-			if (!newFilePath)
+			// Note: Keeping the old log file and retrying on the next rotation, this thread also drives
+			//       shedding, metrics and trace flushing, so it can't stop on a transient open failure.
+			if (!oldFilePath)
+				logMessage(logger, ERROR_LOG_LEVEL, "Failed to open a new log file.");
+			if (!isClosed)
+				logMessage(logger, WARN_LOG_LEVEL, "Failed to truncate a rotated log file.");
+
+			if (oldFilePath)
 			{
-				unlockMutex(mutex);
-				logMessage(logger, ERROR_LOG_LEVEL, "Failed to allocate a new log file path string.");
-				return;
+				compressLogFile(logger, oldFilePath);
+				free(oldFilePath);
 			}
 
-			FILE* newLogFile = openFile(newFilePath, "a");
-			if (!newLogFile)
+			char* oldTracePath = NULL;
+			if (logger->tracer && !rotateLogTracer(logger->tracer, logger->directoryPath, &oldTracePath))
+				logMessage(logger, ERROR_LOG_LEVEL, "Failed to open a new trace file.");
+			if (oldTracePath)
 			{
-				unlockMutex(mutex);
-				logMessage(logger, ERROR_LOG_LEVEL, "Failed to open a new log file.");
-				free(newFilePath);
-				return;
+				compressLogFile(logger, oldTracePath);
+				free(oldTracePath);
 			}
+		}
 
-			char* oldFilePath = logger->filePath;
-			logger->filePath = newFilePath;
-			closeFile(logger->logFile);
-			logger->logFile = newLogFile;
-			timeDelay = currentTime + logger->rotationTime;
-			unlockMutex(mutex);
+		if (rotationTime > 0.0 && timeDelay < nextTime)
+			nextTime = timeDelay;
+
+		if (logger->forwarder && takeLogForwarderThreadFailure(logger->forwarder))
+			logMessage(logger, WARN_LOG_LEVEL, "Failed to apply forwarder thread options.");
+		if (logger->tracer)
+			flushLogTracer(logger->tracer);
+		if (logger->metrics)
+		{
+			double metricsTime = updateLogMetrics(logger->metrics, currentTime);
+			if (metricsTime < nextTime)
+				nextTime = metricsTime;
+		}
+		if (logger->shedder)
+		{
+			double shedTime = updateLogShedding(logger, currentTime);
+			if (shedTime < nextTime)
+				nextTime = shedTime;
+		}
 
-			compressLogFile(logger, oldFilePath);
-			free(oldFilePath);
+		// Note: Not waiting with the logger mutex, writer can hold it for the whole disk stall.
+		lockMutex(updateMutex);
+		if (logger->isRunning)
+		{
+			double delay = nextTime - getCurrentClock();
+			if (delay > 0.0)
+				waitCondFor(updateCond, updateMutex, (int64_t)(delay * 1000000000.0));
 		}
+		bool isRunning = logger->isRunning;
+		unlockMutex(updateMutex);
 
-		sleepThread(0.001);
+		if (!isRunning)
+			break;
 	}
 
+	if (rotationTime <= 0.0)
+		return;
+
 	lockMutex(mutex);
-	closeFile(logger->logFile);
-	logger->logFile = NULL;
-	compressLogFile(logger, logger->filePath);
+	destroyLogWriter(logger->writer);
+	logger->writer = NULL;
+	compressLogFile(NULL, logger->filePath);
 	unlockMutex(mutex);
 }
 
 //**********************************************************************************************************************
-LogyResult createLogger(const char* _directoryPath, LogLevel level, bool logToStdout,
-	double rotationTime, bool isAppDataDirectory, Logger* logger)
+LogyResult createLoggerExt(const char* _directoryPath, LogLevel level, bool logToStdout,
+	double rotationTime, bool isAppDataDirectory, const LoggerOptions* options, Logger* logger)
 {
 	assert(_directoryPath);
 	assert(level < LOG_LEVEL_COUNT);
@@ -202,6 +255,9 @@ LogyResult createLogger(const char* _directoryPath, LogLevel level, bool logToSt
 
 	loggerInstance->rotationTime = rotationTime;
 	loggerInstance->level = level;
+	loggerInstance->shedLevel = ALL_LOG_LEVEL;
+	if (options)
+		loggerInstance->threadOptions = options->threadOptions;
 	loggerInstance->logToStdout = logToStdout;
 
 	size_t directoryPathLength = strlen(_directoryPath);
@@ -254,16 +310,119 @@ LogyResult createLogger(const char* _directoryPath, LogLevel level, bool logToSt
 	}
 	loggerInstance->mutex = mutex;
 
-	FILE* logFile = openFile(filePath, "w");
-	if (!logFile)
+	if (options && options->ringCapacity > 0)
+	{
+		LogRing* ring = createLogRing(options->ringCapacity, options->ringMemoryLimit);
+		if (!ring)
+		{
+			destroyLogger(loggerInstance);
+			return FAILED_TO_ALLOCATE_LOGY_RESULT;
+		}
+		loggerInstance->ring = ring;
+	}
+
+	if (options && options->spanBufferCapacity > 0)
+	{
+		LogTracer* tracer = createLogTracer(directoryPath, options->spanBufferCapacity, rotationTime > 0.0);
+		if (!tracer)
+		{
+			destroyLogger(loggerInstance);
+			return FAILED_TO_OPEN_FILE_LOGY_RESULT;
+		}
+		loggerInstance->tracer = tracer;
+	}
+
+	if (options && options->metricsInterval > 0.0)
+	{
+		LogMetrics* metrics = createLogMetrics(directoryPath, options->metricsFormat, options->metricsInterval);
+		if (!metrics)
+		{
+			destroyLogger(loggerInstance);
+			return FAILED_TO_ALLOCATE_LOGY_RESULT;
+		}
+		loggerInstance->metrics = metrics;
+	}
+
+	// Note: Forwarding is ignored on the unsupported platforms, see the forward.h
+	if (LOGY_FORWARD_SUPPORT && options && options->forwardSocketPath)
+	{
+		LogForwarder* forwarder = createLogForwarder(directoryPath, options->forwardSocketPath, options->forwardType,
+			options->forwardSyslog, options->forwardSpoolLimit, &options->threadOptions);
+		if (!forwarder)
+		{
+			destroyLogger(loggerInstance);
+			return FAILED_TO_OPEN_FILE_LOGY_RESULT;
+		}
+		loggerInstance->forwarder = forwarder;
+	}
+
+	if (options && (options->shedLatency > 0.0 || options->shedBacklog > 0))
+	{
+		LogShedder* shedder = createLogShedder(options->shedLatency,
+			options->shedBacklog, options->shedRecoveryTime, options->shedMinLevel);
+		if (!shedder)
+		{
+			destroyLogger(loggerInstance);
+			return FAILED_TO_ALLOCATE_LOGY_RESULT;
+		}
+		loggerInstance->shedder = shedder;
+	}
+
+	LogWriterType writerType = options ? options->writerType : STDIO_LOG_WRITER_TYPE;
+
+	// Note: Direct writer rewrites the padded last block on each flush, so it needs backend batching.
+	if (writerType == DIRECT_LOG_WRITER_TYPE && !options->backend)
+		writerType = VECTORED_LOG_WRITER_TYPE;
+	LogWriter writer = createLogWriter(writerType, filePath, false);
+	if (!writer)
 	{
 		destroyLogger(loggerInstance);
 		return FAILED_TO_OPEN_FILE_LOGY_RESULT;
 	}
-	loggerInstance->logFile = logFile;
+	loggerInstance->writer = writer;
 
-	if (rotationTime > 0.0)
+	// Note: Rotated files use actual writer type, in case of the fallback.
+	loggerInstance->writerType = getLogWriterType(writer);
+
+	LogBackend backend = options ? options->backend : NULL;
+	if (backend)
 	{
+		Mutex backendMutex = createMutex();
+		if (!backendMutex)
+		{
+			destroyLogger(loggerInstance);
+			return FAILED_TO_ALLOCATE_LOGY_RESULT;
+		}
+		loggerInstance->backendMutex = backendMutex;
+
+		loggerInstance->backendQueueCapacity = options->backendQueueCapacity;
+		if (!attachLogBackend(backend, loggerInstance))
+		{
+			destroyLogger(loggerInstance);
+			return FAILED_TO_ALLOCATE_LOGY_RESULT;
+		}
+		loggerInstance->backend = backend;
+	}
+	else if (rotationTime > 0.0 || loggerInstance->tracer || loggerInstance->metrics ||
+		loggerInstance->shedder || loggerInstance->forwarder)
+	{
+		Mutex updateMutex = createMutex();
+		if (!updateMutex)
+		{
+			destroyLogger(loggerInstance);
+			return FAILED_TO_ALLOCATE_LOGY_RESULT;
+		}
+		loggerInstance->updateMutex = updateMutex;
+
+		Cond updateCond = createCond();
+		if (!updateCond)
+		{
+			destroyLogger(loggerInstance);
+			return FAILED_TO_ALLOCATE_LOGY_RESULT;
+		}
+		loggerInstance->updateCond = updateCond;
+
+		loggerInstance->isRunning = true;
 		Thread rotationThread = createThread(onRotationUpdate, loggerInstance);
 		if (!rotationThread)
 		{
@@ -280,20 +439,41 @@ LogyResult createLogger(const char* _directoryPath, LogLevel level, bool logToSt
 	*logger = loggerInstance;
 	return SUCCESS_LOGY_RESULT;
 }
+LogyResult createLogger(const char* directoryPath, LogLevel level,
+	bool logToStdout, double rotationTime, bool isAppDataDirectory, Logger* logger)
+{
+	return createLoggerExt(directoryPath, level, logToStdout,
+		rotationTime, isAppDataDirectory, NULL, logger);
+}
 void destroyLogger(Logger logger)
 {
 	if (!logger) return;
 
+	if (logger->backend)
+		detachLogBackend(logger->backend, logger);
+
 	Thread rotationThread = logger->rotationThread;
 	if (rotationThread)
 	{
-		logger->rotationTime = 0.0;
+		lockMutex(logger->updateMutex);
+		logger->isRunning = false;
+		signalCond(logger->updateCond);
+		unlockMutex(logger->updateMutex);
 		joinThread(rotationThread);
 		destroyThread(rotationThread);
 	}
 
-	if (logger->logFile) closeFile(logger->logFile);
-
+	if (logger->writer) destroyLogWriter(logger->writer);
+
+	destroyLogShedder(logger->shedder);
+	destroyLogForwarder(logger->forwarder);
+	destroyLogMetrics(logger->metrics);
+	destroyLogTracer(logger->tracer);
+	destroyLogRing(logger->ring);
+	destroyLogCategories(logger);
+	destroyCond(logger->updateCond);
+	destroyMutex(logger->updateMutex);
+	destroyMutex(logger->backendMutex);
 	destroyMutex(logger->mutex);
 	free(logger->filePath);
 	free(logger->directoryPath);
@@ -301,6 +481,29 @@ void destroyLogger(Logger logger)
 }
 
 //**********************************************************************************************************************
+LogBackend getLoggerBackend(Logger logger)
+{
+	assert(logger);
+	return logger->backend;
+}
+uint64_t getLoggerBackendDropCount(Logger logger)
+{
+	assert(logger);
+	lockMutex(logger->mutex);
+	uint64_t dropCount = logger->backendDropCount;
+	unlockMutex(logger->mutex);
+	return dropCount;
+}
+uint64_t getLoggerWriteFailCount(Logger logger)
+{
+	assert(logger);
+	return logyAtomicLoad64(&logger->writeFailCount);
+}
+LogWriterType getLoggerWriterType(Logger logger)
+{
+	assert(logger);
+	return logger->writerType;
+}
 const char* getLoggerDirectoryPath(Logger logger)
 {
 	assert(logger);
@@ -324,11 +527,7 @@ double getLoggerRotationTime(Logger logger)
 LogLevel getLoggerLevel(Logger logger)
 {
 	assert(logger);
-	Mutex mutex = logger->mutex;
-	lockMutex(mutex);
-	LogLevel level = logger->level;
-	unlockMutex(mutex);
-	return level;
+	return (LogLevel)logyAtomicLoad32(&logger->level);
 }
 void setLoggerLevel(Logger logger, LogLevel level)
 {
@@ -336,7 +535,8 @@ void setLoggerLevel(Logger logger, LogLevel level)
 	assert(level <= ALL_LOG_LEVEL);
 	Mutex mutex = logger->mutex;
 	lockMutex(mutex);
-	logger->level = level;
+	logyAtomicStore32(&logger->level, level);
+	updateLogCategoryLevels(logger);
 	unlockMutex(mutex);
 }
 
@@ -359,85 +559,327 @@ void setLoggerLogToStdout(Logger logger, bool logToStdout)
 }
 
 //**********************************************************************************************************************
-void logMessageVA(Logger logger, LogLevel level, const char* fmt, va_list args)
+void setLogHeaderTime(LogHeader* header, time_t rawTime, int milliseconds)
 {
-	assert(logger);
-	assert(level < ALL_LOG_LEVEL);
-	assert(fmt);
+	assert(header);
+	header->rawTime = rawTime;
+	header->milliseconds = milliseconds;
 
-	Mutex mutex = logger->mutex;
-	lockMutex(mutex);
+	#if __linux__ || __APPLE__
+	if (!gmtime_r(&rawTime, &header->timeInfo)) abort();
+	#elif _WIN32
+	if (gmtime_s(&header->timeInfo, &rawTime) != 0) abort();
+	#else
+	#error Unknown operating system
+	#endif
+}
+void getLogHeaderTime(time_t* rawTime, int* milliseconds)
+{
+	assert(rawTime);
+	assert(milliseconds);
+	time(rawTime);
+	double clock = getCurrentClock();
+	*milliseconds = (int)((clock - floor(clock)) * 1000.0);
+}
+static void getLogHeader(LogHeader* header)
+{
+	assert(header);
+	time_t rawTime;
+	int milliseconds;
+	getLogHeaderTime(&rawTime, &milliseconds);
+	setLogHeaderTime(header, rawTime, milliseconds);
+	getThreadName(header->threadName, 16);
+}
+static int formatLogTags(char* buffer, size_t bufferSize, const char* category, const char* context,
+	const LogCallSite* callSite, const char* nameColor, const char* resetColor)
+{
+	assert(buffer);
+	assert(nameColor);
+	assert(resetColor);
 
-	if (level > logger->level)
+	int length = 0;
+	if (category)
 	{
-		unlockMutex(mutex);
-		return;
+		length = snprintf(buffer, bufferSize, " [%s%s%s]", nameColor, category, resetColor);
+		if (length < 0 || (size_t)length >= bufferSize) return -1;
+	}
+	if (context)
+	{
+		int count = snprintf(buffer + length, bufferSize - length, " [%s%s%s]", nameColor, context, resetColor);
+		if (count < 0 || (size_t)(length + count) >= bufferSize) return -1;
+		length += count;
+	}
+	if (callSite)
+	{
+		const char* fileName = callSite->fileName ? callSite->fileName : callSite->filePath;
+		int count = snprintf(buffer + length, bufferSize - length, " [%s%s:%u%s]",
+			nameColor, fileName, callSite->line, resetColor);
+		if (count < 0 || (size_t)(length + count) >= bufferSize) return -1;
+		length += count;
 	}
 
-	time_t rawTime;
-	struct tm timeInfo;
-	time(&rawTime);
+	if ((size_t)length + 3 > bufferSize) return -1;
+	buffer[length++] = ':';
+	buffer[length++] = ' ';
+	buffer[length] = '\0';
+	return length;
+}
+static char* formatLogRecord(char* buffer, const LogHeader* header, const char* category,
+	const char* context, const LogCallSite* callSite, LogLevel level, const char* fmt, va_list args,
+	size_t* recordLength, size_t* headerLength)
+{
+	assert(buffer);
+	assert(header);
+	assert(fmt);
+	assert(recordLength);
+	assert(headerLength);
+
+	const struct tm* timeInfo = &header->timeInfo;
+	int headLength = snprintf(buffer, LOG_RECORD_BUFFER_SIZE,
+		"[%d-%02d-%02d %02d:%02d:%02d.%03d] [%s] [%s]",
+		timeInfo->tm_year + 1900, timeInfo->tm_mon + 1,
+		timeInfo->tm_mday, timeInfo->tm_hour,
+		timeInfo->tm_min, timeInfo->tm_sec, header->milliseconds,
+		header->threadName, logLevelToString(level));
+	if (headLength <= 0 || headLength >= LOG_RECORD_BUFFER_SIZE) return NULL;
+
+	int tagLength = formatLogTags(buffer + headLength,
+		LOG_RECORD_BUFFER_SIZE - headLength, category, context, callSite, "", "");
+	if (tagLength < 0) return NULL;
+	headLength += tagLength;
+
+	va_list formatArgs;
+	va_copy(formatArgs, args);
+	int messageLength = vsnprintf(buffer + headLength,
+		LOG_RECORD_BUFFER_SIZE - headLength, fmt, formatArgs);
+	va_end(formatArgs);
+	if (messageLength < 0) return NULL;
+
+	// Note: reserving space for the new line and null terminator.
+	size_t length = (size_t)headLength + messageLength;
+	char* record = buffer;
+
+	if (length + 2 > LOG_RECORD_BUFFER_SIZE)
+	{
+		record = malloc((length + 2) * sizeof(char));
+		if (!record) return NULL;
+		memcpy(record, buffer, headLength * sizeof(char));
+		vsnprintf(record + headLength, messageLength + 1, fmt, args);
+	}
 
-	#if __linux__ || __APPLE__
-	if (!gmtime_r(&rawTime, &timeInfo)) abort();
-	#elif _WIN32
-	if (gmtime_s(&timeInfo, &rawTime) != 0) abort();
+	record[length++] = '\n';
+	record[length] = '\0';
+	*recordLength = length;
+	*headerLength = headLength;
+	return record;
+}
+static void printLogRecord(const LogHeader* header, const char* category,
+	const char* context, const LogCallSite* callSite, LogLevel level, const char* message, size_t length)
+{
+	assert(header);
+	assert(message);
+
+	#if _WIN32
+	const char* color = "";
 	#else
-	#error Unknown operating system
+	const char* color;
+	switch (level)
+	{
+	default: color = "\e[0;37m"; break;
+	case FATAL_LOG_LEVEL: color = "\e[0;31m"; break;
+	case ERROR_LOG_LEVEL: color = "\e[0;91m"; break;
+	case WARN_LOG_LEVEL: color = "\e[0;93m"; break;
+	case DEBUG_LOG_LEVEL: color = "\e[0;92m"; break;
+	case TRACE_LOG_LEVEL: color = "\e[0;94m"; break;
+	}
 	#endif
 
-	double clock = getCurrentClock();
-	int milliseconds = (int)((clock - floor(clock)) * 1000.0);
+	char tags[512];
+	if (formatLogTags(tags, 512, category, context, callSite, ANSI_NAME_COLOR, ANSI_RESET_COLOR) < 0)
+		memcpy(tags, ": ", 3 * sizeof(char));
+
+	const struct tm* timeInfo = &header->timeInfo;
+	printf("[" ANSI_NAME_COLOR "%d-%02d-%02d %02d:%02d:%02d.%03d"
+		ANSI_RESET_COLOR "] [" ANSI_NAME_COLOR "%s"
+		ANSI_RESET_COLOR "] [%s%s" ANSI_RESET_COLOR "]%s",
+		timeInfo->tm_year + 1900, timeInfo->tm_mon + 1,
+		timeInfo->tm_mday, timeInfo->tm_hour,
+		timeInfo->tm_min, timeInfo->tm_sec, header->milliseconds,
+		header->threadName, color, logLevelToString(level), tags);
+	fwrite(message, sizeof(char), length, stdout);
+	fflush(stdout);
+}
+
+//**********************************************************************************************************************
+static bool writeLogRecord(Logger logger, const LogHeader* header, const char* category, const char* context,
+	const LogCallSite* callSite, LogLevel level, const char* fmt, va_list args, bool isTryLock)
+{
+	assert(logger);
+	assert(header);
+	assert(level < ALL_LOG_LEVEL);
+	assert(fmt);
 
-	char threadName[16];
-	getThreadName(threadName, 16);
+	char buffer[LOG_RECORD_BUFFER_SIZE];
+	size_t length, headerLength;
+	char* data = formatLogRecord(buffer, header, category,
+		context, callSite, level, fmt, args, &length, &headerLength);
+	if (!data) return true;
 
-	if (logger->logToStdout)
+	LogBackend backend = logger->backend;
+	LogRing* ring = logger->ring;
+	LogForwarder* forwarder = logger->forwarder;
+	LogRecord* record = NULL;
+
+	// Note: Record is shared between the backend queue, ring and forwarder, so message is formatted once.
+	if (backend || ring || forwarder)
 	{
-		#if _WIN32
-		const char* color = "";
-		#else
-		const char* color;
-		switch (level)
+		record = malloc(sizeof(LogRecord) + (length + 1) * sizeof(char));
+		if (!record)
 		{
-		default: color = "\e[0;37m"; break;
-		case FATAL_LOG_LEVEL: color = "\e[0;31m"; break;
-		case ERROR_LOG_LEVEL: color = "\e[0;91m"; break;
-		case WARN_LOG_LEVEL: color = "\e[0;93m"; break;
-		case DEBUG_LOG_LEVEL: color = "\e[0;92m"; break;
-		case TRACE_LOG_LEVEL: color = "\e[0;94m"; break;
+			if (data != buffer) free(data);
+			return true;
 		}
-		#endif
 
-		printf("[" ANSI_NAME_COLOR "%d-%02d-%02d %02d:%02d:%02d.%03d"
-			ANSI_RESET_COLOR "] [" ANSI_NAME_COLOR "%s"
-			ANSI_RESET_COLOR "] [%s%s" ANSI_RESET_COLOR "]: ",
-			timeInfo.tm_year + 1900, timeInfo.tm_mon + 1,
-			timeInfo.tm_mday, timeInfo.tm_hour,
-			timeInfo.tm_min, timeInfo.tm_sec, milliseconds,
-			threadName, color, logLevelToString(level));
+		record->next = NULL;
+		record->retiredNext = NULL;
+		record->sequence = 0;
+		record->time = (double)header->rawTime + header->milliseconds * 0.001;
+		record->refCount = 1;
+		record->length = (uint32_t)length;
+		record->messageOffset = (uint32_t)headerLength;
+		record->callSiteId = callSite ? callSite->id : 0;
+		record->level = level;
+		memcpy(record->threadName, header->threadName, 16 * sizeof(char));
+		memcpy(record->data, data, (length + 1) * sizeof(char));
+	}
+
+	Mutex mutex = logger->mutex;
+	if (isTryLock)
+	{
+		if (!tryLockMutex(mutex))
+		{
+			if (record) releaseLogRecord(record);
+			if (data != buffer) free(data);
+			return false;
+		}
+	}
+	else
+	{
+		lockMutex(mutex);
+	}
+
+	if (ring)
+		pushLogRing(ring, record);
+	if (forwarder)
+		pushLogForwarder(forwarder, record);
 
-		va_list stdArgs;
-		va_copy(stdArgs, args);
-		vfprintf(stdout, fmt, stdArgs);
-		va_end(stdArgs);
+	// Note: Measuring only stdout and file output, which are blocking the calling thread.
+	LogShedder* shedder = logger->shedder;
+	bool isMeasured = shedder && (logger->logToStdout || !backend);
+	double writeBeginTime = isMeasured ? beginLogShedWrite(shedder) : 0.0;
 
-		fputc('\n', stdout);
-		fflush(stdout);
+	if (logger->logToStdout)
+		printLogRecord(header, category, context, callSite, level, data + headerLength, length - headerLength);
+	if (!backend)
+	{
+		uint32_t failCount = writeLogData(logger->writer, data, length);
+		if (failCount > 0)
+			logyAtomicFetchAdd64(&logger->writeFailCount, failCount);
 	}
 
-	FILE* logFile = logger->logFile;
+	if (isMeasured)
+		endLogShedWrite(shedder, writeBeginTime);
 
-	fprintf(logFile, "[%d-%02d-%02d %02d:%02d:%02d.%03d] [%s] [%s]: ",
-		timeInfo.tm_year + 1900, timeInfo.tm_mon + 1,
-		timeInfo.tm_mday, timeInfo.tm_hour,
-		timeInfo.tm_min, timeInfo.tm_sec, milliseconds,
-		threadName, logLevelToString(level));
+	bool wakeBackend = false, isQueued = false;
+	uint32_t queueCapacity = logger->backendQueueCapacity;
 
-	vfprintf(logFile, fmt, args);
-	fputc('\n', logFile);
-	fflush(logFile);
+	// Note: Dropping record instead of growing the queue, if backend thread can't keep up.
+	if (backend && queueCapacity > 0 && logger->recordCount >= queueCapacity)
+	{
+		logger->backendDropCount++;
+	}
+	else if (backend)
+	{
+		if (logger->recordTail)
+		{
+			logger->recordTail->next = record;
+		}
+		else
+		{
+			logger->recordHead = record;
+			wakeBackend = true;
+		}
+		logger->recordTail = record;
+		isQueued = true;
+
+		uint32_t recordCount = logger->recordCount + 1;
+		logyAtomicStore32(&logger->recordCount, recordCount);
+		if (shedder)
+			checkLogShedBacklog(logger, recordCount);
+	}
 	unlockMutex(mutex);
+
+	if (logger->metrics)
+		countLogMessage(logger->metrics, level, callSite ? callSite->id : 0);
+
+	if (wakeBackend)
+		wakeLogBackend(backend);
+	if (record && !isQueued)
+		releaseLogRecord(record);
+	if (data != buffer)
+		free(data);
+	return true;
+}
+void writeLogRecordVA(Logger logger, const LogHeader* header, const char* category, const char* context,
+	const LogCallSite* callSite, LogLevel level, const char* fmt, va_list args)
+{
+	writeLogRecord(logger, header, category, context, callSite, level, fmt, args, false);
+}
+void writeLogMessageVA(Logger logger, const char* category,
+	const LogCallSite* callSite, LogLevel level, const char* fmt, va_list args)
+{
+	assert(logger);
+	assert(level < ALL_LOG_LEVEL);
+	assert(fmt);
+
+	// Note: Deferred messages of the failed scope should be written before the error.
+	if (level <= ERROR_LOG_LEVEL)
+		failThreadLogDeferrals(logger);
+
+	LogHeader header;
+	getLogHeader(&header);
+
+	// Note: Thread context prefix is rendered only when context changes.
+	const char* context = getLogContextPrefix();
+	if (context[0] == '\0')
+		context = NULL;
+
+	writeLogRecordVA(logger, &header, category, context, callSite, level, fmt, args);
+}
+bool tryWriteLogMessageVA(Logger logger, LogLevel level, const char* fmt, va_list args)
+{
+	assert(logger);
+	assert(level < ALL_LOG_LEVEL);
+	assert(fmt);
+
+	LogHeader header;
+	getLogHeader(&header);
+	return writeLogRecord(logger, &header, NULL, NULL, NULL, level, fmt, args, true);
+}
+void logMessageVA(Logger logger, LogLevel level, const char* fmt, va_list args)
+{
+	assert(logger);
+	assert(level < ALL_LOG_LEVEL);
+	assert(fmt);
+
+	if (level > logyAtomicLoad32(&logger->level))
+	{
+		deferLogMessageVA(logger, NULL, NULL, level, fmt, args);
+		return;
+	}
+	if (isLogMessageShed(logger, level))
+		return;
+	writeLogMessageVA(logger, NULL, NULL, level, fmt, args);
 }
 void logMessage(Logger logger, LogLevel level, const char* fmt, ...)
 {
@@ -449,3 +891,12 @@ void logMessage(Logger logger, LogLevel level, const char* fmt, ...)
 	logMessageVA(logger, level, fmt, args);
 	va_end(args);
 }
+
+void flushLogger(Logger logger)
+{
+	assert(logger);
+	if (logger->backend)
+		flushLogBackend(logger->backend, logger);
+	if (logger->tracer)
+		flushLogTracer(logger->tracer);
+}
\ No newline at end of file
@@ -0,0 +1,686 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "logy/metrics.h"
+#include "internal.h"
+#include "mpio/file.h"
+
+#include <math.h>
+#include <string.h>
+
+// Note: Each counter is written only by the owning thread, so it is incremented with a plain load and an atomic
+//       store, without the read-modify-write operation. Counters of the exited thread are added to the retired
+//       counters on the next aggregation and its memory is released, so totals are still sums of the list.
+
+#define CALL_SITE_COUNTER_PAGE_SIZE 1024
+#define CALL_SITE_COUNTER_PAGE_COUNT 1024
+#define MIN_METRIC_BUCKET_EXPONENT -31
+
+typedef struct LogHistogram
+{
+	uint64_t counts[LOG_METRIC_BUCKET_COUNT];
+	uint64_t sum;
+} LogHistogram;
+
+typedef struct ThreadLogMetrics
+{
+	LogThreadNode node;
+	uint64_t levelCounts[LOG_LEVEL_COUNT];
+	uint64_t* volatile callSitePages[CALL_SITE_COUNTER_PAGE_COUNT];
+	LogHistogram* volatile histograms[MAX_LOG_METRIC_COUNT];
+} ThreadLogMetrics;
+
+typedef struct LogMetricsWindow
+{
+	uint64_t levelCounts[LOG_LEVEL_COUNT];
+	uint64_t* callSiteCounts;
+	uint32_t callSiteCount;
+	uint32_t callSiteCapacity;
+} LogMetricsWindow;
+
+struct LogMetrics
+{
+	Mutex mutex;
+	LogThreadNode* threads;
+	ThreadLogMetrics* retired;
+	char* filePath;
+	char* tmpFilePath;
+	uint64_t* histogramCounts;
+	double* histogramSums;
+	LogMetricsWindow windows[LOG_METRICS_WINDOW_COUNT + 1];
+	double interval;
+	double nextTime;
+	uint32_t windowIndex;
+	uint32_t windowFill;
+	uint32_t id;
+	LogMetricsFormat format;
+};
+
+static char* metricNames[MAX_LOG_METRIC_COUNT];
+static volatile uint32_t metricNameCount = 0;
+static volatile uint32_t metricNameLock = 0;
+
+//**********************************************************************************************************************
+inline static void incrementCounter(uint64_t* counter, uint64_t value)
+{
+	logyAtomicStoreRelaxed64(counter, *counter + value);
+}
+static void destroyThreadLogMetrics(ThreadLogMetrics* thread)
+{
+	for (uint32_t i = 0; i < CALL_SITE_COUNTER_PAGE_COUNT; i++)
+		free(thread->callSitePages[i]);
+	for (uint32_t i = 0; i < MAX_LOG_METRIC_COUNT; i++)
+		free(thread->histograms[i]);
+	free(thread);
+}
+static uint32_t getMetricBucket(double value)
+{
+	if (!(value > 0.0))
+		return 0;
+	if (isinf(value))
+		return LOG_METRIC_BUCKET_COUNT - 1;
+
+	// Note: Power of two value belongs to the bucket with the same upper bound.
+	int exponent;
+	double mantissa = frexp(value, &exponent);
+	if (mantissa == 0.5)
+		exponent--;
+
+	int bucket = exponent - MIN_METRIC_BUCKET_EXPONENT;
+	if (bucket < 0) return 0;
+	if (bucket >= LOG_METRIC_BUCKET_COUNT) return LOG_METRIC_BUCKET_COUNT - 1;
+	return (uint32_t)bucket;
+}
+static char* createMetricsFilePath(const char* directoryPath, const char* fileName)
+{
+	size_t directoryPathLength = strlen(directoryPath);
+	size_t fileNameLength = strlen(fileName);
+	char* filePath = malloc((directoryPathLength + fileNameLength + 2) * sizeof(char));
+	if (!filePath) return NULL;
+
+	memcpy(filePath, directoryPath, directoryPathLength * sizeof(char));
+	filePath[directoryPathLength] = '/';
+	memcpy(filePath + directoryPathLength + 1, fileName, (fileNameLength + 1) * sizeof(char));
+	return filePath;
+}
+
+//**********************************************************************************************************************
+LogMetrics* createLogMetrics(const char* directoryPath, LogMetricsFormat format, double interval)
+{
+	assert(directoryPath);
+	assert(format < LOG_METRICS_FORMAT_COUNT);
+	assert(interval > 0.0);
+
+	LogMetrics* metrics = calloc(1, sizeof(LogMetrics));
+	if (!metrics) return NULL;
+
+	metrics->interval = interval;
+	metrics->nextTime = getCurrentClock() + interval;
+	metrics->id = createLogThreadOwnerId();
+	metrics->format = format;
+
+	Mutex mutex = createMutex();
+	if (!mutex)
+	{
+		destroyLogMetrics(metrics);
+		return NULL;
+	}
+	metrics->mutex = mutex;
+
+	const char* fileName = format == JSON_LOG_METRICS_FORMAT ?
+		JSON_LOG_METRICS_FILE_NAME : PROMETHEUS_LOG_METRICS_FILE_NAME;
+	char* filePath = createMetricsFilePath(directoryPath, fileName);
+	if (!filePath)
+	{
+		destroyLogMetrics(metrics);
+		return NULL;
+	}
+	metrics->filePath = filePath;
+
+	// Note: Snapshot is written to the temporary file and then renamed, so readers never see partial file.
+	size_t filePathLength = strlen(filePath);
+	char* tmpFilePath = malloc((filePathLength + 5) * sizeof(char));
+	if (!tmpFilePath)
+	{
+		destroyLogMetrics(metrics);
+		return NULL;
+	}
+	memcpy(tmpFilePath, filePath, filePathLength * sizeof(char));
+	memcpy(tmpFilePath + filePathLength, ".tmp", 5 * sizeof(char));
+	metrics->tmpFilePath = tmpFilePath;
+
+	uint64_t* histogramCounts = malloc(MAX_LOG_METRIC_COUNT * LOG_METRIC_BUCKET_COUNT * sizeof(uint64_t));
+	if (!histogramCounts)
+	{
+		destroyLogMetrics(metrics);
+		return NULL;
+	}
+	metrics->histogramCounts = histogramCounts;
+
+	double* histogramSums = malloc(MAX_LOG_METRIC_COUNT * sizeof(double));
+	if (!histogramSums)
+	{
+		destroyLogMetrics(metrics);
+		return NULL;
+	}
+	metrics->histogramSums = histogramSums;
+	return metrics;
+}
+void destroyLogMetrics(LogMetrics* metrics)
+{
+	if (!metrics) return;
+
+	if (metrics->histogramSums)
+		writeLogMetrics(metrics);
+
+	LogThreadNode* node = metrics->threads;
+	while (node)
+	{
+		LogThreadNode* next = node->next;
+		releaseLogThreadToken(node->token);
+		destroyThreadLogMetrics((ThreadLogMetrics*)node);
+		node = next;
+	}
+
+	for (uint32_t i = 0; i <= LOG_METRICS_WINDOW_COUNT; i++)
+		free(metrics->windows[i].callSiteCounts);
+
+	free(metrics->histogramSums);
+	free(metrics->histogramCounts);
+	free(metrics->tmpFilePath);
+	free(metrics->filePath);
+	destroyMutex(metrics->mutex);
+	free(metrics);
+}
+
+//**********************************************************************************************************************
+static bool retireThreadLogMetrics(ThreadLogMetrics* retired, const ThreadLogMetrics* thread)
+{
+	assert(retired);
+	assert(thread);
+
+	// Note: Pages are allocated before adding anything, so failed retirement is retried on the next aggregation.
+	for (uint32_t i = 0; i < CALL_SITE_COUNTER_PAGE_COUNT; i++)
+	{
+		if (!thread->callSitePages[i] || retired->callSitePages[i])
+			continue;
+		uint64_t* page = calloc(CALL_SITE_COUNTER_PAGE_SIZE, sizeof(uint64_t));
+		if (!page) return false;
+		retired->callSitePages[i] = page;
+	}
+	for (uint32_t i = 0; i < MAX_LOG_METRIC_COUNT; i++)
+	{
+		if (!thread->histograms[i] || retired->histograms[i])
+			continue;
+		LogHistogram* histogram = calloc(1, sizeof(LogHistogram));
+		if (!histogram) return false;
+		retired->histograms[i] = histogram;
+	}
+
+	for (uint32_t i = 0; i < LOG_LEVEL_COUNT; i++)
+		retired->levelCounts[i] += thread->levelCounts[i];
+
+	for (uint32_t i = 0; i < CALL_SITE_COUNTER_PAGE_COUNT; i++)
+	{
+		const uint64_t* page = thread->callSitePages[i];
+		if (!page) continue;
+		uint64_t* retiredPage = retired->callSitePages[i];
+		for (uint32_t j = 0; j < CALL_SITE_COUNTER_PAGE_SIZE; j++)
+			retiredPage[j] += page[j];
+	}
+	for (uint32_t i = 0; i < MAX_LOG_METRIC_COUNT; i++)
+	{
+		const LogHistogram* histogram = thread->histograms[i];
+		if (!histogram) continue;
+		LogHistogram* retiredHistogram = retired->histograms[i];
+		for (uint32_t j = 0; j < LOG_METRIC_BUCKET_COUNT; j++)
+			retiredHistogram->counts[j] += histogram->counts[j];
+
+		double sum, retiredSum;
+		memcpy(&sum, &histogram->sum, sizeof(double));
+		memcpy(&retiredSum, &retiredHistogram->sum, sizeof(double));
+		retiredSum += sum;
+		memcpy(&retiredHistogram->sum, &retiredSum, sizeof(double));
+	}
+	return true;
+}
+static void reclaimThreadLogMetrics(LogMetrics* metrics)
+{
+	assert(metrics);
+
+	LogThreadNode** link = &metrics->threads;
+	while (*link)
+	{
+		LogThreadNode* node = *link;
+		if (!isLogThreadExited(node))
+		{
+			link = &node->next;
+			continue;
+		}
+
+		ThreadLogMetrics* retired = metrics->retired;
+		if (!retired)
+		{
+			// Note: Retired counters have no token, so no thread ever finds them in the list.
+			retired = calloc(1, sizeof(ThreadLogMetrics));
+			if (!retired) return;
+			retired->node.next = metrics->threads;
+			metrics->threads = &retired->node;
+			metrics->retired = retired;
+			continue;
+		}
+		if (!retireThreadLogMetrics(retired, (const ThreadLogMetrics*)node))
+			return;
+
+		*link = node->next;
+		releaseLogThreadToken(node->token);
+		destroyThreadLogMetrics((ThreadLogMetrics*)node);
+	}
+}
+
+static bool aggregateLogMetrics(LogMetrics* metrics, LogMetricsWindow* window, uint32_t metricCount)
+{
+	assert(metrics);
+	assert(window);
+
+	uint32_t callSiteCount = getLogCallSiteCount();
+	if (callSiteCount > window->callSiteCapacity)
+	{
+		uint64_t* callSiteCounts = realloc(window->callSiteCounts, callSiteCount * sizeof(uint64_t));
+		if (!callSiteCounts) return false;
+		window->callSiteCounts = callSiteCounts;
+		window->callSiteCapacity = callSiteCount;
+	}
+
+	uint64_t* levelCounts = window->levelCounts;
+	uint64_t* callSiteCounts = window->callSiteCounts;
+	uint64_t* histogramCounts = metrics->histogramCounts;
+	double* histogramSums = metrics->histogramSums;
+	uint32_t pageCount = (callSiteCount + CALL_SITE_COUNTER_PAGE_SIZE - 1) / CALL_SITE_COUNTER_PAGE_SIZE;
+
+	memset(levelCounts, 0, LOG_LEVEL_COUNT * sizeof(uint64_t));
+	if (callSiteCount > 0)
+		memset(callSiteCounts, 0, callSiteCount * sizeof(uint64_t));
+	memset(histogramCounts, 0, metricCount * LOG_METRIC_BUCKET_COUNT * sizeof(uint64_t));
+	memset(histogramSums, 0, metricCount * sizeof(double));
+	window->callSiteCount = callSiteCount;
+
+	lockMutex(metrics->mutex);
+	reclaimThreadLogMetrics(metrics);
+
+	const LogThreadNode* node = metrics->threads;
+	while (node)
+	{
+		const ThreadLogMetrics* thread = (const ThreadLogMetrics*)node;
+		for (uint32_t i = 0; i < LOG_LEVEL_COUNT; i++)
+			levelCounts[i] += logyAtomicLoad64(&thread->levelCounts[i]);
+
+		for (uint32_t i = 0; i < pageCount; i++)
+		{
+			uint64_t* page = logyAtomicLoadPointer(&thread->callSitePages[i]);
+			if (!page) continue;
+
+			uint32_t offset = i * CALL_SITE_COUNTER_PAGE_SIZE;
+			uint32_t count = callSiteCount - offset < CALL_SITE_COUNTER_PAGE_SIZE ?
+				callSiteCount - offset : CALL_SITE_COUNTER_PAGE_SIZE;
+			for (uint32_t j = 0; j < count; j++)
+				callSiteCounts[offset + j] += logyAtomicLoad64(&page[j]);
+		}
+
+		for (uint32_t i = 0; i < metricCount; i++)
+		{
+			LogHistogram* histogram = logyAtomicLoadPointer(&thread->histograms[i]);
+			if (!histogram) continue;
+
+			uint64_t* counts = histogramCounts + (size_t)i * LOG_METRIC_BUCKET_COUNT;
+			for (uint32_t j = 0; j < LOG_METRIC_BUCKET_COUNT; j++)
+				counts[j] += logyAtomicLoad64(&histogram->counts[j]);
+
+			uint64_t sumBits = logyAtomicLoad64(&histogram->sum);
+			double sum;
+			memcpy(&sum, &sumBits, sizeof(double));
+			histogramSums[i] += sum;
+		}
+		node = node->next;
+	}
+
+	unlockMutex(metrics->mutex);
+	return true;
+}
+
+static void writePrometheusLabel(FILE* file, const char* string)
+{
+	fputc('"', file);
+	for (const char* c = string; *c; c++)
+	{
+		if (*c == '"' || *c == '\\') { fputc('\\', file); fputc(*c, file); }
+		else if (*c == '\n') fputs("\\n", file);
+		else fputc(*c, file);
+	}
+	fputc('"', file);
+}
+static void writePrometheusMetrics(LogMetrics* metrics, FILE* file, const LogMetricsWindow* window,
+	const LogMetricsWindow* baseWindow, uint32_t metricCount)
+{
+	fprintf(file, "# HELP logy_metrics_window_seconds Rolling window duration.\n"
+		"# TYPE logy_metrics_window_seconds gauge\nlogy_metrics_window_seconds %g\n",
+		metrics->interval * LOG_METRICS_WINDOW_COUNT);
+
+	fputs("# HELP logy_messages_total Written log message count.\n"
+		"# TYPE logy_messages_total counter\n", file);
+	for (LogLevel i = FATAL_LOG_LEVEL; i < ALL_LOG_LEVEL; i++)
+	{
+		fprintf(file, "logy_messages_total{level=\"%s\"} %llu\n",
+			logLevelToString(i), (unsigned long long)window->levelCounts[i]);
+	}
+
+	fputs("# HELP logy_messages_window Written log message count over the rolling window.\n"
+		"# TYPE logy_messages_window gauge\n", file);
+	for (LogLevel i = FATAL_LOG_LEVEL; i < ALL_LOG_LEVEL; i++)
+	{
+		fprintf(file, "logy_messages_window{level=\"%s\"} %llu\n", logLevelToString(i),
+			(unsigned long long)(window->levelCounts[i] - baseWindow->levelCounts[i]));
+	}
+
+	for (uint32_t pass = 0; pass < 2; pass++)
+	{
+		if (pass == 0)
+		{
+			fputs("# HELP logy_call_site_messages_total Written call-site message count.\n"
+				"# TYPE logy_call_site_messages_total counter\n", file);
+		}
+		else
+		{
+			fputs("# HELP logy_call_site_messages_window Written call-site message count "
+				"over the rolling window.\n# TYPE logy_call_site_messages_window gauge\n", file);
+		}
+
+		for (uint32_t i = 0; i < window->callSiteCount; i++)
+		{
+			uint64_t count = window->callSiteCounts[i];
+			if (count == 0) continue;
+			if (pass == 1 && i < baseWindow->callSiteCount)
+				count -= baseWindow->callSiteCounts[i];
+
+			const LogCallSite* callSite = getLogCallSite(i + 1);
+			fprintf(file, "logy_call_site_messages_%s{id=\"%u\",file=", pass == 0 ? "total" : "window", i + 1);
+			writePrometheusLabel(file, callSite->fileName ? callSite->fileName : callSite->filePath);
+			fprintf(file, ",line=\"%u\",level=\"%s\"} %llu\n", callSite->line,
+				logLevelToString(callSite->level), (unsigned long long)count);
+		}
+	}
+
+	if (metricCount > 0)
+		fputs("# HELP logy_metric Recorded metric values.\n# TYPE logy_metric histogram\n", file);
+
+	for (uint32_t i = 0; i < metricCount; i++)
+	{
+		const uint64_t* counts = metrics->histogramCounts + (size_t)i * LOG_METRIC_BUCKET_COUNT;
+		const char* name = metricNames[i];
+		uint64_t count = 0;
+
+		// Note: Writing only non-empty buckets, to keep the snapshot compact.
+		for (uint32_t j = 0; j < LOG_METRIC_BUCKET_COUNT - 1; j++)
+		{
+			if (counts[j] == 0) continue;
+			count += counts[j];
+			fputs("logy_metric_bucket{name=", file);
+			writePrometheusLabel(file, name);
+			fprintf(file, ",le=\"%.9g\"} %llu\n", ldexp(1.0, (int)j + MIN_METRIC_BUCKET_EXPONENT),
+				(unsigned long long)count);
+		}
+		count += counts[LOG_METRIC_BUCKET_COUNT - 1];
+
+		fputs("logy_metric_bucket{name=", file);
+		writePrometheusLabel(file, name);
+		fprintf(file, ",le=\"+Inf\"} %llu\nlogy_metric_sum{name=", (unsigned long long)count);
+		writePrometheusLabel(file, name);
+		fprintf(file, "} %.17g\nlogy_metric_count{name=", metrics->histogramSums[i]);
+		writePrometheusLabel(file, name);
+		fprintf(file, "} %llu\n", (unsigned long long)count);
+	}
+}
+static void writeJsonMetrics(LogMetrics* metrics, FILE* file, const LogMetricsWindow* window,
+	const LogMetricsWindow* baseWindow, uint32_t metricCount)
+{
+	fprintf(file, "{\"interval\":%g,\"window\":%g,\"levels\":{", metrics->interval,
+		metrics->interval * LOG_METRICS_WINDOW_COUNT);
+	for (LogLevel i = FATAL_LOG_LEVEL; i < ALL_LOG_LEVEL; i++)
+	{
+		fprintf(file, "%s\"%s\":{\"total\":%llu,\"window\":%llu}", i > FATAL_LOG_LEVEL ? "," : "",
+			logLevelToString(i), (unsigned long long)window->levelCounts[i],
+			(unsigned long long)(window->levelCounts[i] - baseWindow->levelCounts[i]));
+	}
+
+	fputs("},\n\"callSites\":[", file);
+	bool isFirst = true;
+	for (uint32_t i = 0; i < window->callSiteCount; i++)
+	{
+		uint64_t count = window->callSiteCounts[i];
+		if (count == 0) continue;
+		uint64_t baseCount = i < baseWindow->callSiteCount ? baseWindow->callSiteCounts[i] : 0;
+
+		const LogCallSite* callSite = getLogCallSite(i + 1);
+		fprintf(file, "%s\n{\"id\":%u,\"file\":", isFirst ? "" : ",", i + 1);
+		writeLogJsonString(file, callSite->fileName ? callSite->fileName : callSite->filePath);
+		fprintf(file, ",\"line\":%u,\"level\":\"%s\",\"total\":%llu,\"window\":%llu}", callSite->line,
+			logLevelToString(callSite->level), (unsigned long long)count, (unsigned long long)(count - baseCount));
+		isFirst = false;
+	}
+
+	fputs("],\n\"metrics\":[", file);
+	for (uint32_t i = 0; i < metricCount; i++)
+	{
+		const uint64_t* counts = metrics->histogramCounts + (size_t)i * LOG_METRIC_BUCKET_COUNT;
+		uint64_t count = 0;
+
+		fprintf(file, "%s\n{\"name\":", i > 0 ? "," : "");
+		writeLogJsonString(file, metricNames[i]);
+		fputs(",\"buckets\":[", file);
+
+		// Note: Unbounded bucket upper bound is written as null.
+		isFirst = true;
+		for (uint32_t j = 0; j < LOG_METRIC_BUCKET_COUNT; j++)
+		{
+			if (counts[j] == 0) continue;
+			count += counts[j];
+			if (j < LOG_METRIC_BUCKET_COUNT - 1)
+			{
+				fprintf(file, "%s{\"le\":%.9g,\"count\":%llu}", isFirst ? "" : ",",
+					ldexp(1.0, (int)j + MIN_METRIC_BUCKET_EXPONENT), (unsigned long long)counts[j]);
+			}
+			else
+			{
+				fprintf(file, "%s{\"le\":null,\"count\":%llu}", isFirst ? "" : ",", (unsigned long long)counts[j]);
+			}
+			isFirst = false;
+		}
+
+		fprintf(file, "],\"count\":%llu,\"sum\":%.17g}", (unsigned long long)count, metrics->histogramSums[i]);
+	}
+	fputs("]}\n", file);
+}
+
+void writeLogMetrics(LogMetrics* metrics)
+{
+	assert(metrics);
+
+	uint32_t windowIndex = metrics->windowIndex;
+	LogMetricsWindow* window = &metrics->windows[windowIndex];
+	uint32_t metricCount = logyAtomicLoad32(&metricNameCount);
+	if (!aggregateLogMetrics(metrics, window, metricCount))
+		return;
+
+	// Note: Window slot after the current one holds totals of the window start, or totals are zero before it.
+	static const LogMetricsWindow emptyWindow;
+	const LogMetricsWindow* baseWindow = &emptyWindow;
+	if (metrics->windowFill >= LOG_METRICS_WINDOW_COUNT)
+		baseWindow = &metrics->windows[(windowIndex + 1) % (LOG_METRICS_WINDOW_COUNT + 1)];
+	else
+		metrics->windowFill++;
+	metrics->windowIndex = (windowIndex + 1) % (LOG_METRICS_WINDOW_COUNT + 1);
+
+	FILE* file = openFile(metrics->tmpFilePath, "w");
+	if (!file) return;
+
+	if (metrics->format == JSON_LOG_METRICS_FORMAT)
+		writeJsonMetrics(metrics, file, window, baseWindow, metricCount);
+	else
+		writePrometheusMetrics(metrics, file, window, baseWindow, metricCount);
+	closeFile(file);
+
+	#if _WIN32
+	remove(metrics->filePath);
+	#endif
+	rename(metrics->tmpFilePath, metrics->filePath);
+}
+double updateLogMetrics(LogMetrics* metrics, double currentTime)
+{
+	assert(metrics);
+	if (currentTime < metrics->nextTime)
+		return metrics->nextTime;
+
+	writeLogMetrics(metrics);
+	metrics->nextTime = currentTime + metrics->interval;
+	return metrics->nextTime;
+}
+
+//**********************************************************************************************************************
+static LogThreadNode* createThreadLogMetrics(void* owner)
+{
+	assert(owner);
+	ThreadLogMetrics* thread = calloc(1, sizeof(ThreadLogMetrics));
+	return thread ? &thread->node : NULL;
+}
+inline static ThreadLogMetrics* getThreadLogMetrics(LogMetrics* metrics)
+{
+	return (ThreadLogMetrics*)getLogThreadNode(metrics->id, metrics->mutex,
+		&metrics->threads, createThreadLogMetrics, metrics);
+}
+
+void countLogMessage(LogMetrics* metrics, LogLevel level, uint32_t callSiteId)
+{
+	assert(metrics);
+	assert(level < LOG_LEVEL_COUNT);
+
+	ThreadLogMetrics* thread = getThreadLogMetrics(metrics);
+	if (!thread) return;
+
+	incrementCounter(&thread->levelCounts[level], 1);
+	if (callSiteId == 0)
+		return;
+
+	uint32_t index = callSiteId - 1;
+	uint64_t* page = thread->callSitePages[index / CALL_SITE_COUNTER_PAGE_SIZE];
+	if (!page)
+	{
+		page = calloc(CALL_SITE_COUNTER_PAGE_SIZE, sizeof(uint64_t));
+		if (!page) return;
+		(void)logyAtomicExchangePointer(&thread->callSitePages[index / CALL_SITE_COUNTER_PAGE_SIZE], page);
+	}
+	incrementCounter(&page[index % CALL_SITE_COUNTER_PAGE_SIZE], 1);
+}
+
+//**********************************************************************************************************************
+uint32_t registerLogMetric(const char* name)
+{
+	assert(name);
+
+	lockLogSpin(&metricNameLock);
+
+	uint32_t nameCount = metricNameCount;
+	for (uint32_t i = 0; i < nameCount; i++)
+	{
+		if (strcmp(metricNames[i], name) != 0)
+			continue;
+		unlockLogSpin(&metricNameLock);
+		return i + 1;
+	}
+
+	size_t nameLength = strlen(name);
+	char* nameCopy = nameCount < MAX_LOG_METRIC_COUNT ? malloc((nameLength + 1) * sizeof(char)) : NULL;
+	if (!nameCopy)
+	{
+		unlockLogSpin(&metricNameLock);
+		return 0;
+	}
+
+	memcpy(nameCopy, name, (nameLength + 1) * sizeof(char));
+	metricNames[nameCount] = nameCopy;
+	logyAtomicStore32(&metricNameCount, nameCount + 1);
+	unlockLogSpin(&metricNameLock);
+	return nameCount + 1;
+}
+const char* getLogMetricName(uint32_t metricId)
+{
+	if (metricId == 0 || metricId > logyAtomicLoad32(&metricNameCount))
+		return NULL;
+	return metricNames[metricId - 1];
+}
+
+bool isLoggerMetricsEnabled(Logger logger)
+{
+	assert(logger);
+	return logger->metrics != NULL;
+}
+
+void logMetric(Logger logger, uint32_t metricId, double value)
+{
+	assert(logger);
+	assert(metricId <= logyAtomicLoad32(&metricNameCount));
+
+	LogMetrics* metrics = logger->metrics;
+	if (!metrics || metricId == 0)
+		return;
+
+	ThreadLogMetrics* thread = getThreadLogMetrics(metrics);
+	if (!thread) return;
+
+	LogHistogram* histogram = thread->histograms[metricId - 1];
+	if (!histogram)
+	{
+		histogram = calloc(1, sizeof(LogHistogram));
+		if (!histogram) return;
+		(void)logyAtomicExchangePointer(&thread->histograms[metricId - 1], histogram);
+	}
+
+	incrementCounter(&histogram->counts[getMetricBucket(value)], 1);
+
+	double sum;
+	memcpy(&sum, &histogram->sum, sizeof(double));
+	sum += value;
+	uint64_t sumBits;
+	memcpy(&sumBits, &sum, sizeof(double));
+	logyAtomicStoreRelaxed64(&histogram->sum, sumBits);
+}
+
+uint64_t getLoggerMessageCount(Logger logger, LogLevel level)
+{
+	assert(logger);
+	assert(level < LOG_LEVEL_COUNT);
+
+	LogMetrics* metrics = logger->metrics;
+	if (!metrics) return 0;
+
+	uint64_t count = 0;
+	lockMutex(metrics->mutex);
+	const LogThreadNode* node = metrics->threads;
+	while (node)
+	{
+		count += logyAtomicLoad64(&((const ThreadLogMetrics*)node)->levelCounts[level]);
+		node = node->next;
+	}
+	unlockMutex(metrics->mutex);
+	return count;
+}
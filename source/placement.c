@@ -0,0 +1,87 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if __linux__ && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "internal.h"
+
+#if __linux__
+#include <sched.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#elif __APPLE__
+#include <pthread.h>
+#include <pthread/qos.h>
+#elif _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+//**********************************************************************************************************************
+bool applyLogThreadOptions(const LogThreadOptions* options)
+{
+	assert(options);
+	assert(options->policy < LOG_THREAD_POLICY_COUNT);
+	bool result = true;
+
+	#if __linux__
+	if (options->affinityMask != 0)
+	{
+		cpu_set_t cpuSet;
+		CPU_ZERO(&cpuSet);
+		for (uint32_t i = 0; i < 64; i++)
+		{
+			if (options->affinityMask & (1ull << i))
+				CPU_SET(i, &cpuSet);
+		}
+		result &= sched_setaffinity(0, sizeof(cpu_set_t), &cpuSet) == 0;
+	}
+	if (options->policy != DEFAULT_LOG_THREAD_POLICY)
+	{
+		struct sched_param param;
+		memset(&param, 0, sizeof(struct sched_param));
+		int policy = options->policy == IDLE_LOG_THREAD_POLICY ? SCHED_IDLE : SCHED_BATCH;
+		result &= sched_setscheduler(0, policy, &param) == 0;
+	}
+	if (options->niceValue != 0)
+	{
+		// Note: Linux nice value is per-thread, when it is set for the thread identifier.
+		result &= setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), options->niceValue) == 0;
+	}
+	#elif __APPLE__
+	// Note: macOS has no thread affinity and per-thread nice value, using the QoS classes instead.
+	if (options->policy != DEFAULT_LOG_THREAD_POLICY)
+	{
+		qos_class_t qosClass = options->policy == IDLE_LOG_THREAD_POLICY ?
+			QOS_CLASS_BACKGROUND : QOS_CLASS_UTILITY;
+		result &= pthread_set_qos_class_self_np(qosClass, 0) == 0;
+	}
+	#elif _WIN32
+	HANDLE thread = GetCurrentThread();
+	if (options->affinityMask != 0)
+		result &= SetThreadAffinityMask(thread, (DWORD_PTR)options->affinityMask) != 0;
+	if (options->policy != DEFAULT_LOG_THREAD_POLICY)
+	{
+		int priority = options->policy == IDLE_LOG_THREAD_POLICY ?
+			THREAD_PRIORITY_IDLE : THREAD_PRIORITY_BELOW_NORMAL;
+		result &= SetThreadPriority(thread, priority) != 0;
+	}
+	#endif
+
+	return result;
+}
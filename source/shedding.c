@@ -0,0 +1,325 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "logy/shedding.h"
+#include "internal.h"
+
+#include <string.h>
+
+// Note: Write latency and backlog are observed without locking, because writer can hold the logger mutex
+//       for the whole disk stall. Racing maximal latency update may lose one sample, which is fine for the
+//       controller. Level limit transitions are serialized by the shedder mutex, which is never held while writing.
+
+#define LOG_SHED_UPDATE_INTERVAL 0.05
+#define LOG_SHED_STEP_TIME 0.25
+#define MAX_LOG_SHED_RECOVERY_SCALE 64.0
+
+struct LogShedder
+{
+	Mutex mutex;
+	double latencyThreshold;
+	double recoveryTime;
+	double recoveryDelay;
+	double nextTime;
+	double changeTime;
+	double badTime;
+	double lastLatency;
+	double reportLatency;
+	uint64_t writeBeginTime;
+	uint64_t maxLatency;
+	uint64_t suppressedCount;
+	uint64_t reportedCount;
+	uint32_t backlogThreshold;
+	uint32_t lastBacklog;
+	uint32_t reportBacklog;
+	uint32_t transitionCount;
+	LogLevel minLevel;
+	LogLevel level;
+	LogLevel reportedLevel;
+	bool isRestored;
+};
+
+//**********************************************************************************************************************
+inline static double loadShedTime(uint64_t* address)
+{
+	uint64_t bits = logyAtomicLoad64(address);
+	double value;
+	memcpy(&value, &bits, sizeof(double));
+	return value;
+}
+inline static void storeShedTime(uint64_t* address, double value)
+{
+	uint64_t bits;
+	memcpy(&bits, &value, sizeof(double));
+	logyAtomicStore64(address, bits);
+}
+
+static bool raiseShedLevel(Logger logger, LogShedder* shedder,
+	double currentTime, double latency, uint32_t backlog)
+{
+	if (latency > shedder->reportLatency)
+		shedder->reportLatency = latency;
+	if (backlog > shedder->reportBacklog)
+		shedder->reportBacklog = backlog;
+	if (currentTime - shedder->changeTime < LOG_SHED_STEP_TIME)
+		return false;
+
+	// Note: Dropping the most verbose enabled level, configured level can be changed while shedding.
+	LogLevel loggerLevel = (LogLevel)logyAtomicLoad32(&logger->level);
+	LogLevel level = shedder->level < loggerLevel ? shedder->level : loggerLevel;
+	if (level <= shedder->minLevel)
+		return false;
+
+	// Note: Doubling recovery delay if overload returns right after the relaxation, to stop level flapping.
+	if (shedder->isRestored && currentTime - shedder->changeTime < shedder->recoveryDelay * 2.0)
+	{
+		double maxRecoveryDelay = shedder->recoveryTime * MAX_LOG_SHED_RECOVERY_SCALE;
+		shedder->recoveryDelay = shedder->recoveryDelay * 2.0 < maxRecoveryDelay ?
+			shedder->recoveryDelay * 2.0 : maxRecoveryDelay;
+	}
+
+	shedder->level = level - 1;
+	shedder->changeTime = currentTime;
+	shedder->isRestored = false;
+	shedder->transitionCount++;
+	logyAtomicStore32(&logger->shedLevel, shedder->level);
+	return true;
+}
+static bool restoreShedLevel(Logger logger, LogShedder* shedder, double currentTime)
+{
+	double recoveryDelay = shedder->recoveryDelay;
+	if (shedder->level == ALL_LOG_LEVEL)
+	{
+		if (currentTime - shedder->changeTime >= recoveryDelay * 2.0)
+			shedder->recoveryDelay = shedder->recoveryTime;
+		return false;
+	}
+	if (currentTime - shedder->changeTime < recoveryDelay || currentTime - shedder->badTime < recoveryDelay)
+		return false;
+
+	LogLevel level = shedder->level + 1;
+	if (level >= (LogLevel)logyAtomicLoad32(&logger->level))
+		level = ALL_LOG_LEVEL;
+
+	shedder->level = level;
+	shedder->changeTime = currentTime;
+	shedder->transitionCount++;
+	shedder->isRestored = true;
+	logyAtomicStore32(&logger->shedLevel, level);
+	return true;
+}
+static bool logShedMessage(Logger logger, const char* fmt, ...)
+{
+	// Note: Transition messages bypass the level limit. Writer can still hold the logger mutex
+	//       after the stall clears, so the message is not written instead of waiting for it.
+	va_list args;
+	va_start(args, fmt);
+	bool isWritten = tryWriteLogMessageVA(logger, WARN_LOG_LEVEL, fmt, args);
+	va_end(args);
+	return isWritten;
+}
+
+//**********************************************************************************************************************
+LogShedder* createLogShedder(double latencyThreshold, uint32_t backlogThreshold,
+	double recoveryTime, LogLevel minLevel)
+{
+	assert(latencyThreshold > 0.0 || backlogThreshold > 0);
+	assert(recoveryTime >= 0.0);
+	assert(minLevel < ALL_LOG_LEVEL);
+
+	LogShedder* shedder = calloc(1, sizeof(LogShedder));
+	if (!shedder) return NULL;
+
+	double currentTime = getCurrentClock();
+	shedder->latencyThreshold = latencyThreshold;
+	shedder->recoveryTime = recoveryTime;
+	shedder->recoveryDelay = recoveryTime;
+	shedder->nextTime = currentTime + LOG_SHED_UPDATE_INTERVAL;
+	shedder->changeTime = currentTime - LOG_SHED_STEP_TIME;
+	shedder->backlogThreshold = backlogThreshold;
+	shedder->minLevel = minLevel;
+	shedder->level = ALL_LOG_LEVEL;
+	shedder->reportedLevel = ALL_LOG_LEVEL;
+
+	Mutex mutex = createMutex();
+	if (!mutex)
+	{
+		destroyLogShedder(shedder);
+		return NULL;
+	}
+	shedder->mutex = mutex;
+	return shedder;
+}
+void destroyLogShedder(LogShedder* shedder)
+{
+	if (!shedder) return;
+	destroyMutex(shedder->mutex);
+	free(shedder);
+}
+
+//**********************************************************************************************************************
+double beginLogShedWrite(LogShedder* shedder)
+{
+	assert(shedder);
+	double currentTime = getCurrentClock();
+	storeShedTime(&shedder->writeBeginTime, currentTime);
+	return currentTime;
+}
+void endLogShedWrite(LogShedder* shedder, double beginTime)
+{
+	assert(shedder);
+	double latency = getCurrentClock() - beginTime;
+	storeShedTime(&shedder->writeBeginTime, 0.0);
+	if (latency > loadShedTime(&shedder->maxLatency))
+		storeShedTime(&shedder->maxLatency, latency);
+}
+void checkLogShedBacklog(Logger logger, uint32_t backlog)
+{
+	assert(logger);
+	LogShedder* shedder = logger->shedder;
+	assert(shedder);
+
+	// Note: Backend thread can't update shedding while it is stalled, so message writers raise the limit.
+	if (shedder->backlogThreshold == 0 || backlog <= shedder->backlogThreshold)
+		return;
+
+	lockMutex(shedder->mutex);
+	double currentTime = getCurrentClock();
+	shedder->badTime = currentTime;
+	raiseShedLevel(logger, shedder, currentTime, 0.0, backlog);
+	unlockMutex(shedder->mutex);
+}
+void countShedLogMessage(Logger logger)
+{
+	assert(logger);
+	assert(logger->shedder);
+	logyAtomicFetchAdd64(&logger->shedder->suppressedCount, 1);
+}
+
+double updateLogShedding(Logger logger, double currentTime)
+{
+	assert(logger);
+	LogShedder* shedder = logger->shedder;
+	assert(shedder);
+
+	if (currentTime < shedder->nextTime)
+		return shedder->nextTime;
+	shedder->nextTime = currentTime + LOG_SHED_UPDATE_INTERVAL;
+
+	double latency = loadShedTime(&shedder->maxLatency);
+	storeShedTime(&shedder->maxLatency, 0.0);
+	double writeBeginTime = loadShedTime(&shedder->writeBeginTime);
+	if (writeBeginTime > 0.0 && currentTime - writeBeginTime > latency)
+		latency = currentTime - writeBeginTime;
+	uint32_t backlog = logyAtomicLoad32(&logger->recordCount);
+
+	double latencyThreshold = shedder->latencyThreshold;
+	uint32_t backlogThreshold = shedder->backlogThreshold;
+	bool isOverloaded = (latencyThreshold > 0.0 && latency > latencyThreshold) ||
+		(backlogThreshold > 0 && backlog > backlogThreshold);
+	bool isRecovered = (latencyThreshold <= 0.0 || latency < latencyThreshold * 0.5) &&
+		(backlogThreshold == 0 || backlog < backlogThreshold / 2);
+
+	lockMutex(shedder->mutex);
+	shedder->lastLatency = latency;
+	shedder->lastBacklog = backlog;
+
+	// Note: Keeping the limit while latency or backlog is between the half and full threshold. (Hysteresis)
+	if (!isRecovered)
+		shedder->badTime = currentTime;
+	if (isOverloaded)
+		raiseShedLevel(logger, shedder, currentTime, latency, backlog);
+	else if (isRecovered)
+		restoreShedLevel(logger, shedder, currentTime);
+
+	LogLevel level = shedder->level, reportedLevel = shedder->reportedLevel;
+	double reportLatency = shedder->reportLatency;
+	uint32_t reportBacklog = shedder->reportBacklog;
+	unlockMutex(shedder->mutex);
+
+	if (level == reportedLevel)
+		return shedder->nextTime;
+
+	// Note: Reporting the transition after the write stall clears, because message write would block too.
+	if (writeBeginTime > 0.0 || (latencyThreshold > 0.0 && latency >= latencyThreshold * 0.5))
+		return shedder->nextTime;
+
+	uint64_t suppressedCount = logyAtomicLoad64(&shedder->suppressedCount);
+	uint64_t reportedCount = shedder->reportedCount;
+	bool isReported;
+
+	if (level < reportedLevel)
+	{
+		isReported = logShedMessage(logger, "Load shedding limited logging level to %s. "
+			"(write latency: %.3f s, backlog: %u, suppressed: %llu)", logLevelToString(level),
+			reportLatency, reportBacklog, (unsigned long long)(suppressedCount - reportedCount));
+	}
+	else if (level != ALL_LOG_LEVEL)
+	{
+		isReported = logShedMessage(logger, "Load shedding relaxed logging level limit to %s. (suppressed: %llu)",
+			logLevelToString(level), (unsigned long long)(suppressedCount - reportedCount));
+	}
+	else
+	{
+		isReported = logShedMessage(logger, "Load shedding stopped. (suppressed: %llu)",
+			(unsigned long long)(suppressedCount - reportedCount));
+	}
+
+	if (isReported)
+	{
+		shedder->reportedLevel = level;
+		shedder->reportedCount = suppressedCount;
+
+		lockMutex(shedder->mutex);
+		shedder->reportLatency = 0.0;
+		shedder->reportBacklog = 0;
+		unlockMutex(shedder->mutex);
+	}
+	return shedder->nextTime;
+}
+
+//**********************************************************************************************************************
+bool isLoggerShedding(Logger logger)
+{
+	assert(logger);
+	return logyAtomicLoad32(&logger->shedLevel) != ALL_LOG_LEVEL;
+}
+LogLevel getLoggerEffectiveLevel(Logger logger)
+{
+	assert(logger);
+	uint32_t level = logyAtomicLoad32(&logger->level);
+	uint32_t shedLevel = logyAtomicLoad32(&logger->shedLevel);
+	return (LogLevel)(shedLevel < level ? shedLevel : level);
+}
+LogShedStats getLoggerShedStats(Logger logger)
+{
+	assert(logger);
+
+	LogShedStats stats;
+	memset(&stats, 0, sizeof(LogShedStats));
+	stats.level = ALL_LOG_LEVEL;
+
+	LogShedder* shedder = logger->shedder;
+	if (!shedder) return stats;
+
+	lockMutex(shedder->mutex);
+	stats.writeLatency = shedder->lastLatency;
+	stats.backlog = shedder->lastBacklog;
+	stats.transitionCount = shedder->transitionCount;
+	stats.level = shedder->level;
+	unlockMutex(shedder->mutex);
+
+	stats.suppressedCount = logyAtomicLoad64(&shedder->suppressedCount);
+	return stats;
+}
@@ -0,0 +1,255 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "logy/snapshot.h"
+#include "internal.h"
+
+#include <string.h>
+
+// Note: Ring records are written only under the logger mutex. Snapshot readers increment
+//       the reader counter of the current epoch before loading ring slots. Evicted records are
+//       kept on the retired list of the current epoch. Writer releases the previous epoch list
+//       once its readers leave and starts a new epoch, so continuous overlapping snapshots
+//       hold at most two epochs of evicted records instead of blocking their release.
+
+struct LogSnapshot_T
+{
+	LogRecord** records;
+	size_t count;
+};
+
+//**********************************************************************************************************************
+LogRing* createLogRing(uint32_t capacity, size_t memoryLimit)
+{
+	assert(capacity > 0);
+
+	LogRing* ring = calloc(1, sizeof(LogRing));
+	if (!ring) return NULL;
+
+	LogRecord* volatile* records = calloc(capacity, sizeof(LogRecord*));
+	if (!records)
+	{
+		free(ring);
+		return NULL;
+	}
+
+	ring->records = records;
+	ring->memoryLimit = memoryLimit > 0 ? memoryLimit : SIZE_MAX;
+	ring->capacity = capacity;
+	return ring;
+}
+static void releaseRetiredRecords(LogRing* ring, uint32_t epochIndex)
+{
+	assert(ring);
+	LogRecord* record = ring->retiredRecords[epochIndex];
+	ring->retiredRecords[epochIndex] = NULL;
+
+	while (record)
+	{
+		LogRecord* next = record->retiredNext;
+		releaseLogRecord(record);
+		record = next;
+	}
+}
+void destroyLogRing(LogRing* ring)
+{
+	if (!ring) return;
+	assert(ring->readerCounts[0] == 0 && ring->readerCounts[1] == 0);
+
+	LogRecord* volatile* records = ring->records;
+	uint32_t capacity = ring->capacity;
+
+	for (uint32_t i = 0; i < capacity; i++)
+	{
+		if (records[i])
+			releaseLogRecord(records[i]);
+	}
+
+	releaseRetiredRecords(ring, 0);
+	releaseRetiredRecords(ring, 1);
+	free((void*)records);
+	free(ring);
+}
+
+//**********************************************************************************************************************
+static void retireRecord(LogRing* ring, LogRecord* record)
+{
+	assert(ring);
+	assert(record);
+
+	ring->memorySize -= record->length;
+	ring->count--;
+
+	if (logyAtomicLoad32(&ring->readerCounts[0]) == 0 && logyAtomicLoad32(&ring->readerCounts[1]) == 0)
+	{
+		releaseLogRecord(record);
+		return;
+	}
+
+	uint32_t epochIndex = ring->epoch & 1;
+	record->retiredNext = ring->retiredRecords[epochIndex];
+	ring->retiredRecords[epochIndex] = record;
+}
+static void reclaimRetiredRecords(LogRing* ring)
+{
+	assert(ring);
+
+	// Note: New readers join the current epoch, so the previous one is drained by the readers leaving.
+	uint32_t epoch = ring->epoch;
+	uint32_t previousIndex = (epoch + 1) & 1;
+	if (logyAtomicLoad32(&ring->readerCounts[previousIndex]) != 0)
+		return;
+
+	releaseRetiredRecords(ring, previousIndex);
+	logyAtomicStore32(&ring->epoch, epoch + 1);
+}
+void pushLogRing(LogRing* ring, LogRecord* record)
+{
+	assert(ring);
+	assert(record);
+
+	if (record->length > ring->memoryLimit)
+		return;
+
+	LogRecord* volatile* records = ring->records;
+	uint32_t capacity = ring->capacity;
+
+	while (ring->count > 0 && (ring->count == capacity ||
+		ring->memorySize + record->length > ring->memoryLimit))
+	{
+		uint32_t oldestIndex = (ring->index + capacity - ring->count) % capacity;
+		LogRecord* oldRecord = logyAtomicExchangePointer(&records[oldestIndex], NULL);
+		retireRecord(ring, oldRecord);
+	}
+
+	retainLogRecord(record);
+	record->sequence = ring->sequence++;
+	(void)logyAtomicExchangePointer(&records[ring->index], record);
+	ring->index = (ring->index + 1) % capacity;
+	ring->memorySize += record->length;
+	ring->count++;
+
+	if (ring->retiredRecords[0] || ring->retiredRecords[1])
+		reclaimRetiredRecords(ring);
+}
+
+//**********************************************************************************************************************
+static bool isRecordMatching(const LogRecord* record, const LogFilter* filter)
+{
+	if (!filter)
+		return true;
+	if (record->level > filter->level || record->time < filter->minTime || record->time > filter->maxTime)
+		return false;
+	if (filter->threadName && strncmp(record->threadName, filter->threadName, 16) != 0)
+		return false;
+	return true;
+}
+static int compareRecords(const void* a, const void* b)
+{
+	uint64_t sequenceA = (*(const LogRecord* const*)a)->sequence;
+	uint64_t sequenceB = (*(const LogRecord* const*)b)->sequence;
+	return sequenceA < sequenceB ? -1 : (sequenceA > sequenceB ? 1 : 0);
+}
+
+LogyResult createLogSnapshot(Logger logger, const LogFilter* filter, LogSnapshot* snapshot)
+{
+	assert(logger);
+	assert(snapshot);
+
+	LogSnapshot snapshotInstance = calloc(1, sizeof(LogSnapshot_T));
+	if (!snapshotInstance)
+		return FAILED_TO_ALLOCATE_LOGY_RESULT;
+
+	LogRing* ring = logger->ring;
+	if (!ring)
+	{
+		*snapshot = snapshotInstance;
+		return SUCCESS_LOGY_RESULT;
+	}
+
+	uint32_t capacity = ring->capacity;
+	LogRecord** records = malloc(capacity * sizeof(LogRecord*));
+	if (!records)
+	{
+		free(snapshotInstance);
+		return FAILED_TO_ALLOCATE_LOGY_RESULT;
+	}
+
+	LogRecord* volatile* ringRecords = ring->records;
+	size_t count = 0;
+
+	// Note: Rechecking the epoch, writer could have released its retired records before the increment.
+	uint32_t epochIndex;
+	while (true)
+	{
+		uint32_t epoch = logyAtomicLoad32(&ring->epoch);
+		epochIndex = epoch & 1;
+		logyAtomicFetchAdd32(&ring->readerCounts[epochIndex], 1);
+		if (logyAtomicLoad32(&ring->epoch) == epoch)
+			break;
+		logyAtomicFetchAdd32(&ring->readerCounts[epochIndex], -1);
+	}
+
+	for (uint32_t i = 0; i < capacity; i++)
+	{
+		LogRecord* record = logyAtomicLoadPointer(&ringRecords[i]);
+		if (!record || !isRecordMatching(record, filter))
+			continue;
+		retainLogRecord(record);
+		records[count++] = record;
+	}
+	logyAtomicFetchAdd32(&ring->readerCounts[epochIndex], -1);
+
+	qsort(records, count, sizeof(LogRecord*), compareRecords);
+	snapshotInstance->records = records;
+	snapshotInstance->count = count;
+	*snapshot = snapshotInstance;
+	return SUCCESS_LOGY_RESULT;
+}
+void destroyLogSnapshot(LogSnapshot snapshot)
+{
+	if (!snapshot) return;
+
+	LogRecord** records = snapshot->records;
+	size_t count = snapshot->count;
+
+	for (size_t i = 0; i < count; i++)
+		releaseLogRecord(records[i]);
+
+	free(records);
+	free(snapshot);
+}
+
+//**********************************************************************************************************************
+size_t getLogSnapshotSize(LogSnapshot snapshot)
+{
+	assert(snapshot);
+	return snapshot->count;
+}
+LogEntry getLogSnapshotEntry(LogSnapshot snapshot, size_t index)
+{
+	assert(snapshot);
+	assert(index < snapshot->count);
+
+	const LogRecord* record = snapshot->records[index];
+	LogEntry entry;
+	entry.record = record->data;
+	entry.message = record->data + record->messageOffset;
+	entry.threadName = record->threadName;
+	entry.time = record->time;
+	entry.length = record->length;
+	entry.callSiteId = record->callSiteId;
+	entry.level = record->level;
+	return entry;
+}
@@ -0,0 +1,482 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "logy/span.h"
+#include "internal.h"
+#include "mpio/file.h"
+
+#include <string.h>
+
+#if __linux__ || __APPLE__
+#include <time.h>
+#include <unistd.h>
+#elif _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <process.h>
+#else
+#error Unknown operating system
+#endif
+
+#define SPAN_NAME_PAGE_SIZE 256
+#define SPAN_NAME_PAGE_COUNT 256
+
+typedef struct LogSpanEvent
+{
+	uint64_t beginTime;
+	uint64_t endTime;
+	uint32_t nameId;
+} LogSpanEvent;
+
+typedef struct LogSpanBuffer
+{
+	LogThreadNode node;
+	LogSpanEvent* events;
+	volatile uint32_t writeIndex;
+	volatile uint32_t readIndex;
+	volatile uint32_t dropCount;
+	uint32_t writtenDropCount;
+	uint32_t threadId;
+} LogSpanBuffer;
+
+struct LogTracer
+{
+	Mutex mutex;
+	FILE* file;
+	char* filePath;
+	LogThreadNode* buffers;
+	uint64_t originTime;
+	double clockFrequency;
+	uint32_t id;
+	uint32_t bufferMask;
+	uint32_t bufferCount;
+	uint32_t processId;
+	bool hasEvents;
+};
+
+static char** volatile spanNamePages[SPAN_NAME_PAGE_COUNT];
+static volatile uint32_t spanNameCount = 0;
+static volatile uint32_t spanNameLock = 0;
+
+//**********************************************************************************************************************
+inline static uint64_t getSpanClock()
+{
+	#if __linux__ || __APPLE__
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return (uint64_t)time.tv_sec * 1000000000ull + (uint64_t)time.tv_nsec;
+	#elif _WIN32
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+	return (uint64_t)counter.QuadPart;
+	#endif
+}
+static double getSpanClockFrequency()
+{
+	#if __linux__ || __APPLE__
+	return 1000000000.0;
+	#elif _WIN32
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	return (double)frequency.QuadPart;
+	#endif
+}
+inline static const char* getRegisteredSpanName(uint32_t nameId)
+{
+	uint32_t index = nameId - 1;
+	return spanNamePages[index / SPAN_NAME_PAGE_SIZE][index % SPAN_NAME_PAGE_SIZE];
+}
+
+void writeLogJsonString(FILE* file, const char* string)
+{
+	fputc('"', file);
+	for (const char* c = string; *c; c++)
+	{
+		if (*c == '"' || *c == '\\')
+		{
+			fputc('\\', file);
+			fputc(*c, file);
+		}
+		else if ((uint8_t)*c < 0x20)
+		{
+			fprintf(file, "\\u%04x", (uint8_t)*c);
+		}
+		else
+		{
+			fputc(*c, file);
+		}
+	}
+	fputc('"', file);
+}
+static void beginTraceEvent(LogTracer* tracer)
+{
+	fputs(tracer->hasEvents ? ",\n" : "\n", tracer->file);
+	tracer->hasEvents = true;
+}
+static void writeTraceTime(FILE* file, const char* key, uint64_t ticks, double clockFrequency)
+{
+	// Note: Trace time is in microseconds, formatting it as integers is faster than floating point.
+	uint64_t nanoseconds = clockFrequency == 1000000000.0 ? ticks :
+		(uint64_t)((double)ticks * (1000000000.0 / clockFrequency));
+	fprintf(file, ",\"%s\":%llu.%03u", key, (unsigned long long)(nanoseconds / 1000),
+		(uint32_t)(nanoseconds % 1000));
+}
+
+//**********************************************************************************************************************
+static FILE* openTraceFile(const char* filePath)
+{
+	assert(filePath);
+	FILE* file = openFile(filePath, "w");
+	if (!file) return NULL;
+
+	// Note: Trace viewers accept unterminated event array, so file stays readable if process crashes.
+	fputc('[', file);
+	fflush(file);
+	return file;
+}
+static void closeTraceFile(FILE* file)
+{
+	assert(file);
+	fputs("\n]\n", file);
+	closeFile(file);
+}
+
+//**********************************************************************************************************************
+LogTracer* createLogTracer(const char* directoryPath, uint32_t bufferCapacity, bool useRotation)
+{
+	assert(directoryPath);
+	assert(bufferCapacity > 0);
+
+	LogTracer* tracer = calloc(1, sizeof(LogTracer));
+	if (!tracer) return NULL;
+
+	// Note: Rounding capacity up to the power of two, to replace modulo with the mask.
+	uint32_t capacity = 1;
+	while (capacity < bufferCapacity && capacity < 0x80000000u)
+		capacity <<= 1;
+
+	tracer->originTime = getSpanClock();
+	tracer->clockFrequency = getSpanClockFrequency();
+	tracer->id = createLogThreadOwnerId();
+	tracer->bufferMask = capacity - 1;
+
+	#if _WIN32
+	tracer->processId = (uint32_t)_getpid();
+	#else
+	tracer->processId = (uint32_t)getpid();
+	#endif
+
+	Mutex mutex = createMutex();
+	if (!mutex)
+	{
+		destroyLogTracer(tracer);
+		return NULL;
+	}
+	tracer->mutex = mutex;
+
+	char* filePath = createLogFilePathExt(directoryPath, "trace", "json", useRotation);
+	if (!filePath)
+	{
+		destroyLogTracer(tracer);
+		return NULL;
+	}
+
+	tracer->filePath = filePath;
+
+	FILE* file = openTraceFile(filePath);
+	if (!file)
+	{
+		destroyLogTracer(tracer);
+		return NULL;
+	}
+	tracer->file = file;
+	return tracer;
+}
+void destroyLogTracer(LogTracer* tracer)
+{
+	if (!tracer) return;
+
+	if (tracer->file)
+	{
+		flushLogTracer(tracer);
+		closeTraceFile(tracer->file);
+	}
+
+	LogThreadNode* node = tracer->buffers;
+	while (node)
+	{
+		LogThreadNode* next = node->next;
+		releaseLogThreadToken(node->token);
+		free(((LogSpanBuffer*)node)->events);
+		free(node);
+		node = next;
+	}
+
+	destroyMutex(tracer->mutex);
+	free(tracer->filePath);
+	free(tracer);
+}
+bool rotateLogTracer(LogTracer* tracer, const char* directoryPath, char** oldFilePath)
+{
+	assert(tracer);
+	assert(directoryPath);
+	assert(oldFilePath);
+	*oldFilePath = NULL;
+
+	char* newFilePath = createLogFilePathExt(directoryPath, "trace", "json", true);
+	if (!newFilePath) return false;
+
+	// Note: Keeping the current file if rotated on the same second, reopening would truncate it.
+	if (strcmp(newFilePath, tracer->filePath) == 0)
+	{
+		free(newFilePath);
+		return true;
+	}
+
+	FILE* newFile = openTraceFile(newFilePath);
+	if (!newFile)
+	{
+		free(newFilePath);
+		return false;
+	}
+
+	// Note: Writing buffered spans to the old file, so it covers the whole rotation period.
+	flushLogTracer(tracer);
+
+	lockMutex(tracer->mutex);
+	closeTraceFile(tracer->file);
+	*oldFilePath = tracer->filePath;
+	tracer->file = newFile;
+	tracer->filePath = newFilePath;
+	tracer->hasEvents = false;
+	unlockMutex(tracer->mutex);
+	return true;
+}
+void flushLogTracer(LogTracer* tracer)
+{
+	assert(tracer);
+
+	double clockFrequency = tracer->clockFrequency;
+	uint64_t originTime = tracer->originTime;
+	uint32_t bufferMask = tracer->bufferMask;
+	uint32_t processId = tracer->processId;
+	bool isWritten = false;
+
+	lockMutex(tracer->mutex);
+	FILE* file = tracer->file; // Note: Loading under the mutex, file is replaced on rotation.
+
+	LogThreadNode** link = &tracer->buffers;
+	while (*link)
+	{
+		LogSpanBuffer* buffer = (LogSpanBuffer*)*link;
+
+		// Note: Exit flag is loaded before the write index, so the last spans of the exited thread are not lost.
+		bool isExited = isLogThreadExited(&buffer->node);
+		uint32_t readIndex = buffer->readIndex;
+		uint32_t writeIndex = logyAtomicLoad32(&buffer->writeIndex);
+		const LogSpanEvent* events = buffer->events;
+		uint32_t threadId = buffer->threadId;
+
+		for (uint32_t i = readIndex; i != writeIndex; i++)
+		{
+			const LogSpanEvent* event = &events[i & bufferMask];
+			beginTraceEvent(tracer);
+			fputs("{\"name\":", file);
+			writeLogJsonString(file, getRegisteredSpanName(event->nameId));
+			fputs(",\"ph\":\"X\"", file);
+			writeTraceTime(file, "ts", event->beginTime - originTime, clockFrequency);
+			writeTraceTime(file, "dur", event->endTime - event->beginTime, clockFrequency);
+			fprintf(file, ",\"pid\":%u,\"tid\":%u}", processId, threadId);
+		}
+
+		if (readIndex != writeIndex)
+		{
+			logyAtomicStore32(&buffer->readIndex, writeIndex);
+			isWritten = true;
+		}
+
+		// Note: Reporting spans dropped while the buffer was full, as a counter track of the thread.
+		uint32_t dropCount = logyAtomicLoad32(&buffer->dropCount);
+		if (dropCount != buffer->writtenDropCount)
+		{
+			beginTraceEvent(tracer);
+			fprintf(file, "{\"name\":\"dropped spans %u\",\"ph\":\"C\"", threadId);
+			writeTraceTime(file, "ts", getSpanClock() - originTime, clockFrequency);
+			fprintf(file, ",\"pid\":%u,\"args\":{\"count\":%u}}", processId, dropCount);
+			buffer->writtenDropCount = dropCount;
+			isWritten = true;
+		}
+
+		if (isExited)
+		{
+			*link = buffer->node.next;
+			releaseLogThreadToken(buffer->node.token);
+			free(buffer->events);
+			free(buffer);
+			continue;
+		}
+		link = &buffer->node.next;
+	}
+
+	if (isWritten)
+		fflush(file);
+	unlockMutex(tracer->mutex);
+}
+
+//**********************************************************************************************************************
+static LogThreadNode* createThreadSpanBuffer(void* owner)
+{
+	assert(owner);
+	LogTracer* tracer = (LogTracer*)owner;
+
+	LogSpanBuffer* buffer = calloc(1, sizeof(LogSpanBuffer));
+	if (!buffer) return NULL;
+
+	LogSpanEvent* events = malloc(((size_t)tracer->bufferMask + 1) * sizeof(LogSpanEvent));
+	if (!events)
+	{
+		free(buffer);
+		return NULL;
+	}
+
+	buffer->events = events;
+	buffer->threadId = ++tracer->bufferCount;
+
+	char threadName[16];
+	getThreadName(threadName, 16);
+
+	// Note: Metadata event names the thread track in the trace viewer.
+	FILE* file = tracer->file;
+	beginTraceEvent(tracer);
+	fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":",
+		tracer->processId, buffer->threadId);
+	writeLogJsonString(file, threadName);
+	fputs("}}", file);
+	return &buffer->node;
+}
+inline static LogSpanBuffer* getThreadSpanBuffer(LogTracer* tracer)
+{
+	return (LogSpanBuffer*)getLogThreadNode(tracer->id, tracer->mutex,
+		&tracer->buffers, createThreadSpanBuffer, tracer);
+}
+
+//**********************************************************************************************************************
+uint32_t registerLogSpanName(const char* name)
+{
+	assert(name);
+
+	lockLogSpin(&spanNameLock);
+
+	// Note: Names are registered once per span statement, so linear search is fine here.
+	uint32_t nameCount = spanNameCount;
+	for (uint32_t i = 1; i <= nameCount; i++)
+	{
+		if (strcmp(getRegisteredSpanName(i), name) != 0)
+			continue;
+		unlockLogSpin(&spanNameLock);
+		return i;
+	}
+
+	uint32_t pageIndex = nameCount / SPAN_NAME_PAGE_SIZE;
+	if (pageIndex >= SPAN_NAME_PAGE_COUNT)
+	{
+		unlockLogSpin(&spanNameLock);
+		return 0;
+	}
+
+	char** page = spanNamePages[pageIndex];
+	if (!page)
+	{
+		page = malloc(SPAN_NAME_PAGE_SIZE * sizeof(char*));
+		if (!page)
+		{
+			unlockLogSpin(&spanNameLock);
+			return 0;
+		}
+		(void)logyAtomicExchangePointer(&spanNamePages[pageIndex], page);
+	}
+
+	size_t nameLength = strlen(name);
+	char* nameCopy = malloc((nameLength + 1) * sizeof(char));
+	if (!nameCopy)
+	{
+		unlockLogSpin(&spanNameLock);
+		return 0;
+	}
+
+	memcpy(nameCopy, name, (nameLength + 1) * sizeof(char));
+	page[nameCount % SPAN_NAME_PAGE_SIZE] = nameCopy;
+	logyAtomicStore32(&spanNameCount, nameCount + 1);
+	unlockLogSpin(&spanNameLock);
+	return nameCount + 1;
+}
+const char* getLogSpanName(uint32_t nameId)
+{
+	if (nameId == 0 || nameId > logyAtomicLoad32(&spanNameCount))
+		return NULL;
+	return getRegisteredSpanName(nameId);
+}
+
+bool isLoggerTracing(Logger logger)
+{
+	assert(logger);
+	return logger->tracer != NULL;
+}
+
+//**********************************************************************************************************************
+LogSpan beginLogSpan(Logger logger, uint32_t nameId)
+{
+	assert(logger);
+	assert(nameId <= logyAtomicLoad32(&spanNameCount));
+
+	LogSpan span;
+	if (logger->tracer && nameId != 0)
+	{
+		span.beginTime = getSpanClock();
+		span.nameId = nameId;
+	}
+	else
+	{
+		span.beginTime = 0;
+		span.nameId = 0;
+	}
+	return span;
+}
+void endLogSpan(Logger logger, LogSpan span)
+{
+	assert(logger);
+
+	if (span.nameId == 0)
+		return;
+
+	uint64_t endTime = getSpanClock();
+	LogTracer* tracer = logger->tracer;
+	LogSpanBuffer* buffer = getThreadSpanBuffer(tracer);
+	if (!buffer) return;
+
+	// Note: Buffer is single producer, write index is modified only by this thread.
+	//       Span is dropped if buffer is full, so the calling thread never waits for the trace file writes.
+	uint32_t writeIndex = buffer->writeIndex;
+	if (writeIndex - logyAtomicLoad32(&buffer->readIndex) > tracer->bufferMask)
+	{
+		logyAtomicStoreRelaxed32(&buffer->dropCount, buffer->dropCount + 1);
+		return;
+	}
+
+	LogSpanEvent* event = &buffer->events[writeIndex & tracer->bufferMask];
+	event->beginTime = span.beginTime;
+	event->endTime = endTime;
+	event->nameId = span.nameId;
+	logyAtomicStoreRelease32(&buffer->writeIndex, writeIndex + 1);
+}
@@ -0,0 +1,170 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "logy/context.h"
+#include "internal.h"
+
+#include <string.h>
+
+#if _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+// Note: Thread token identifies the thread in the per-thread lists of the loggers. Each list node holds a token
+//       reference, and the thread holds one more until it exits. Exit callback marks the token, so the owner
+//       can release node memory on its next background update, instead of keeping it until logger destruction.
+//       Cache entries are compared only by the owner identifier, which is never reused. Exit callback also
+//       frees the thread log context buffers.
+
+LOGY_THREAD_LOCAL LogThreadEntry logThreadCache[LOG_THREAD_CACHE_SIZE];
+static LOGY_THREAD_LOCAL LogThreadToken* threadToken = NULL;
+static volatile uint32_t ownerCounter = 0;
+static bool isExitKeyCreated = false;
+
+//**********************************************************************************************************************
+static void onLogThreadExit(LogThreadToken* token)
+{
+	if (!token) return;
+	clearLogContext();
+	memset(logThreadCache, 0, sizeof(logThreadCache));
+	threadToken = NULL;
+	logyAtomicStore32(&token->isExited, 1);
+	releaseLogThreadToken(token);
+}
+
+#if _WIN32
+static DWORD exitKey = FLS_OUT_OF_INDEXES;
+static INIT_ONCE exitKeyOnce = INIT_ONCE_STATIC_INIT;
+
+static VOID NTAPI onFlsThreadExit(PVOID value)
+{
+	onLogThreadExit((LogThreadToken*)value);
+}
+static BOOL CALLBACK createExitKey(PINIT_ONCE initOnce, PVOID parameter, PVOID* context)
+{
+	(void)initOnce; (void)parameter; (void)context;
+	exitKey = FlsAlloc(onFlsThreadExit);
+	isExitKeyCreated = exitKey != FLS_OUT_OF_INDEXES;
+	return TRUE;
+}
+static bool setExitKeyValue(LogThreadToken* token)
+{
+	InitOnceExecuteOnce(&exitKeyOnce, createExitKey, NULL, NULL);
+	return isExitKeyCreated && FlsSetValue(exitKey, token);
+}
+#else
+static pthread_key_t exitKey;
+static pthread_once_t exitKeyOnce = PTHREAD_ONCE_INIT;
+
+static void onPthreadExit(void* value)
+{
+	onLogThreadExit((LogThreadToken*)value);
+}
+static void createExitKey()
+{
+	isExitKeyCreated = pthread_key_create(&exitKey, onPthreadExit) == 0;
+}
+static bool setExitKeyValue(LogThreadToken* token)
+{
+	pthread_once(&exitKeyOnce, createExitKey);
+	return isExitKeyCreated && pthread_setspecific(exitKey, token) == 0;
+}
+#endif
+
+static LogThreadToken* getLogThreadToken()
+{
+	LogThreadToken* token = threadToken;
+	if (token) return token;
+
+	token = calloc(1, sizeof(LogThreadToken));
+	if (!token) return NULL;
+	token->refCount = 1;
+
+	// Note: Without the exit callback token is never marked, so nodes live until the owner is destroyed.
+	(void)setExitKeyValue(token);
+	threadToken = token;
+	return token;
+}
+
+//**********************************************************************************************************************
+uint32_t createLogThreadOwnerId()
+{
+	return logyAtomicFetchAdd32(&ownerCounter, 1) + 1;
+}
+void watchLogThreadExit()
+{
+	(void)getLogThreadToken();
+}
+void releaseLogThreadToken(LogThreadToken* token)
+{
+	if (token && logyAtomicFetchAdd32(&token->refCount, -1) == 1)
+		free(token);
+}
+
+LogThreadNode* findLogThreadNode(uint32_t ownerId, Mutex mutex,
+	LogThreadNode** nodes, CreateLogThreadNode createNode, void* owner)
+{
+	assert(ownerId != 0);
+	assert(mutex);
+	assert(nodes);
+	assert(createNode);
+
+	LogThreadEntry* cache = logThreadCache;
+	uint32_t index = 1;
+
+	while (index < LOG_THREAD_CACHE_SIZE && cache[index].ownerId != ownerId)
+		index++;
+
+	LogThreadNode* node;
+	if (index < LOG_THREAD_CACHE_SIZE)
+	{
+		node = cache[index].node;
+	}
+	else
+	{
+		LogThreadToken* token = getLogThreadToken();
+		if (!token) return NULL;
+
+		// Note: Thread node can be evicted from the cache, if thread writes to many loggers.
+		index = LOG_THREAD_CACHE_SIZE - 1;
+		lockMutex(mutex);
+		node = *nodes;
+		while (node && node->token != token)
+			node = node->next;
+
+		if (!node)
+		{
+			node = createNode(owner);
+			if (node)
+			{
+				logyAtomicFetchAdd32(&token->refCount, 1);
+				node->token = token;
+				node->next = *nodes;
+				*nodes = node;
+			}
+		}
+		unlockMutex(mutex);
+		if (!node) return NULL;
+	}
+
+	// Note: Moving to the front, thread usually writes to the same logger.
+	for (; index > 0; index--)
+		cache[index] = cache[index - 1];
+	cache[0].node = node;
+	cache[0].ownerId = ownerId;
+	return node;
+}
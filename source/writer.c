@@ -0,0 +1,830 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if __linux__ && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // Note: Required for the O_DIRECT and fallocate().
+#endif
+
+#include "internal.h"
+#include "mpio/file.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if __linux__ || __APPLE__
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#define LOGY_VECTORED_SUPPORT 1
+#else
+#define LOGY_VECTORED_SUPPORT 0
+#endif
+
+#ifndef LOGY_IO_URING_SUPPORT
+#define LOGY_IO_URING_SUPPORT 0
+#endif
+
+#if LOGY_IO_URING_SUPPORT
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#endif
+
+#if __linux__ && defined(O_DIRECT)
+#define LOGY_DIRECT_SUPPORT 1
+#else
+#define LOGY_DIRECT_SUPPORT 0
+#endif
+
+#if LOGY_IO_URING_SUPPORT || LOGY_DIRECT_SUPPORT
+#include <sys/mman.h>
+#endif
+
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+
+#define URING_ENTRY_COUNT 4
+#define URING_BUFFER_COUNT 2
+#define URING_BUFFER_SIZE (256 * 1024)
+
+#define DIRECT_BLOCK_SIZE 4096
+#define DIRECT_BUFFER_SIZE (256 * 1024)
+#define DIRECT_EXTENT_SIZE (64 * 1024 * 1024)
+
+#if LOGY_IO_URING_SUPPORT
+typedef struct UringQueue
+{
+	unsigned* sqTail;
+	unsigned* sqMask;
+	unsigned* sqArray;
+	unsigned* cqHead;
+	unsigned* cqTail;
+	unsigned* cqMask;
+	struct io_uring_sqe* sqes;
+	struct io_uring_cqe* cqes;
+	void* sqRing;
+	void* cqRing;
+	size_t sqRingSize;
+	size_t cqRingSize;
+	size_t sqesSize;
+	int ringFile;
+	bool isSingleMap;
+	bool isRegistered;
+	bool isRegisterTried;
+} UringQueue;
+#endif
+
+struct LogWriter_T
+{
+	FILE* file;
+	#if LOGY_IO_URING_SUPPORT
+	UringQueue* uring;
+	char* buffers[URING_BUFFER_COUNT];
+	uint64_t bufferOffsets[URING_BUFFER_COUNT];
+	uint32_t bufferLengths[URING_BUFFER_COUNT];
+	bool isPending[URING_BUFFER_COUNT];
+	uint64_t fileOffset;
+	uint32_t bufferIndex;
+	#endif
+	#if LOGY_DIRECT_SUPPORT
+	char* directBuffer;
+	char* directBlock;
+	uint64_t directOffset;
+	uint64_t allocatedSize;
+	size_t directLength;
+	#endif
+	uint32_t failCount;
+	int descriptor;
+	LogWriterType type;
+};
+
+//**********************************************************************************************************************
+#if LOGY_VECTORED_SUPPORT
+// Note: Write functions retry interrupted calls and return false if the data was not fully written,
+//       for example because of the full disk, so the logger can count it instead of losing it silently.
+static bool writeAllData(int descriptor, const char* data, size_t length)
+{
+	while (length > 0)
+	{
+		ssize_t count = write(descriptor, data, length);
+		if (count <= 0)
+		{
+			if (count < 0 && errno == EINTR)
+				continue;
+			return false;
+		}
+		data += count;
+		length -= count;
+	}
+	return true;
+}
+#if LOGY_IO_URING_SUPPORT || LOGY_DIRECT_SUPPORT
+static bool writeAllDataAt(int descriptor, const char* data, size_t length, off_t fileOffset)
+{
+	while (length > 0)
+	{
+		ssize_t count = pwrite(descriptor, data, length, fileOffset);
+		if (count <= 0)
+		{
+			if (count < 0 && errno == EINTR)
+				continue;
+			return false;
+		}
+		data += count; length -= count; fileOffset += count;
+	}
+	return true;
+}
+#endif
+static bool writeAllVectors(int descriptor, struct iovec* vectors, int vectorCount)
+{
+	while (vectorCount > 0)
+	{
+		ssize_t count = writev(descriptor, vectors, vectorCount);
+		if (count <= 0)
+		{
+			if (count < 0 && errno == EINTR)
+				continue;
+			return false;
+		}
+
+		// Note: Skipping vectors written by the partial write.
+		while (vectorCount > 0 && (size_t)count >= vectors->iov_len)
+		{
+			count -= vectors->iov_len;
+			vectors++;
+			vectorCount--;
+		}
+
+		if (vectorCount > 0)
+		{
+			vectors->iov_base = (char*)vectors->iov_base + count;
+			vectors->iov_len -= count;
+		}
+	}
+	return true;
+}
+#endif
+
+#if LOGY_IO_URING_SUPPORT || LOGY_DIRECT_SUPPORT
+// Note: Large buffers are mapped directly, so their pages are not touched until the first write. Backend thread
+//       does the first write, so the pages are allocated on the NUMA node of its placement (first-touch policy),
+//       even though the writer is created by another thread. Heap could return already touched memory.
+static char* allocateWriterBuffer(size_t size)
+{
+	void* buffer = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	return buffer == MAP_FAILED ? NULL : (char*)buffer;
+}
+static void freeWriterBuffer(char* buffer, size_t size)
+{
+	if (buffer) munmap(buffer, size);
+}
+#endif
+
+//**********************************************************************************************************************
+#if LOGY_IO_URING_SUPPORT
+static void destroyUringQueue(UringQueue* uring)
+{
+	if (!uring) return;
+
+	if (uring->sqes)
+		munmap(uring->sqes, uring->sqesSize);
+	if (uring->cqRing && !uring->isSingleMap)
+		munmap(uring->cqRing, uring->cqRingSize);
+	if (uring->sqRing)
+		munmap(uring->sqRing, uring->sqRingSize);
+	if (uring->ringFile >= 0)
+		close(uring->ringFile);
+	free(uring);
+}
+static UringQueue* createUringQueue()
+{
+	UringQueue* uring = calloc(1, sizeof(UringQueue));
+	if (!uring) return NULL;
+
+	struct io_uring_params params;
+	memset(&params, 0, sizeof(struct io_uring_params));
+	uring->ringFile = (int)syscall(__NR_io_uring_setup, URING_ENTRY_COUNT, &params);
+	if (uring->ringFile < 0)
+	{
+		// Note: io_uring can be disabled by the kernel or seccomp.
+		uring->ringFile = -1;
+		destroyUringQueue(uring);
+		return NULL;
+	}
+
+	uring->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+	uring->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+	uring->isSingleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+
+	if (uring->isSingleMap && uring->cqRingSize > uring->sqRingSize)
+		uring->sqRingSize = uring->cqRingSize;
+
+	void* sqRing = mmap(NULL, uring->sqRingSize, PROT_READ | PROT_WRITE,
+		MAP_SHARED | MAP_POPULATE, uring->ringFile, IORING_OFF_SQ_RING);
+	if (sqRing == MAP_FAILED)
+	{
+		destroyUringQueue(uring);
+		return NULL;
+	}
+	uring->sqRing = sqRing;
+
+	void* cqRing = sqRing;
+	if (!uring->isSingleMap)
+	{
+		cqRing = mmap(NULL, uring->cqRingSize, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, uring->ringFile, IORING_OFF_CQ_RING);
+		if (cqRing == MAP_FAILED)
+		{
+			destroyUringQueue(uring);
+			return NULL;
+		}
+	}
+	uring->cqRing = cqRing;
+
+	uring->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+	void* sqes = mmap(NULL, uring->sqesSize, PROT_READ | PROT_WRITE,
+		MAP_SHARED | MAP_POPULATE, uring->ringFile, IORING_OFF_SQES);
+	if (sqes == MAP_FAILED)
+	{
+		destroyUringQueue(uring);
+		return NULL;
+	}
+	uring->sqes = sqes;
+
+	uring->sqTail = (unsigned*)((char*)sqRing + params.sq_off.tail);
+	uring->sqMask = (unsigned*)((char*)sqRing + params.sq_off.ring_mask);
+	uring->sqArray = (unsigned*)((char*)sqRing + params.sq_off.array);
+	uring->cqHead = (unsigned*)((char*)cqRing + params.cq_off.head);
+	uring->cqTail = (unsigned*)((char*)cqRing + params.cq_off.tail);
+	uring->cqMask = (unsigned*)((char*)cqRing + params.cq_off.ring_mask);
+	uring->cqes = (struct io_uring_cqe*)((char*)cqRing + params.cq_off.cqes);
+	return uring;
+}
+static void registerUringBuffers(LogWriter writer)
+{
+	assert(writer);
+	UringQueue* uring = writer->uring;
+	uring->isRegisterTried = true;
+
+	struct iovec vectors[URING_BUFFER_COUNT];
+	for (uint32_t i = 0; i < URING_BUFFER_COUNT; i++)
+	{
+		vectors[i].iov_base = writer->buffers[i];
+		vectors[i].iov_len = URING_BUFFER_SIZE;
+	}
+
+	// Note: Registration pins the buffer pages, so it is done on the first submit by the writing thread.
+	//       Registration can fail because of the memlock limit, using regular writes then.
+	uring->isRegistered = syscall(__NR_io_uring_register, uring->ringFile,
+		IORING_REGISTER_BUFFERS, vectors, URING_BUFFER_COUNT) == 0;
+}
+
+static void completeUringWrites(LogWriter writer, bool waitAll)
+{
+	assert(writer);
+	UringQueue* uring = writer->uring;
+
+	while (true)
+	{
+		bool isPending = false;
+		for (uint32_t i = 0; i < URING_BUFFER_COUNT; i++)
+			isPending |= writer->isPending[i];
+		if (!isPending)
+			return;
+
+		unsigned head = *uring->cqHead;
+		unsigned tail = __atomic_load_n(uring->cqTail, __ATOMIC_ACQUIRE);
+
+		if (head == tail)
+		{
+			if (!waitAll)
+				return;
+			syscall(__NR_io_uring_enter, uring->ringFile, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+			continue;
+		}
+
+		while (head != tail)
+		{
+			const struct io_uring_cqe* cqe = &uring->cqes[head & *uring->cqMask];
+			uint32_t index = (uint32_t)cqe->user_data;
+			int32_t result = cqe->res;
+			uint32_t length = writer->bufferLengths[index];
+
+			// Note: Writing the rest of the data synchronously on a short write or error.
+			if (result < (int32_t)length)
+			{
+				size_t offset = result > 0 ? (size_t)result : 0;
+				const char* data = writer->buffers[index] + offset;
+				size_t size = length - offset;
+				off_t fileOffset = (off_t)(writer->bufferOffsets[index] + offset);
+				if (!writeAllDataAt(writer->descriptor, data, size, fileOffset))
+					writer->failCount++;
+			}
+
+			writer->isPending[index] = false;
+			head++;
+		}
+
+		__atomic_store_n(uring->cqHead, head, __ATOMIC_RELEASE);
+	}
+}
+static void waitUringBuffer(LogWriter writer, uint32_t index)
+{
+	assert(writer);
+	while (writer->isPending[index])
+	{
+		UringQueue* uring = writer->uring;
+		unsigned head = *uring->cqHead;
+		unsigned tail = __atomic_load_n(uring->cqTail, __ATOMIC_ACQUIRE);
+		if (head == tail)
+			syscall(__NR_io_uring_enter, uring->ringFile, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+		completeUringWrites(writer, false);
+	}
+}
+static void submitUringBuffer(LogWriter writer)
+{
+	assert(writer);
+	uint32_t index = writer->bufferIndex;
+	uint32_t length = writer->bufferLengths[index];
+	if (length == 0) return;
+
+	UringQueue* uring = writer->uring;
+	if (!uring->isRegisterTried)
+		registerUringBuffers(writer);
+
+	unsigned tail = *uring->sqTail;
+	unsigned sqIndex = tail & *uring->sqMask;
+
+	struct io_uring_sqe* sqe = &uring->sqes[sqIndex];
+	memset(sqe, 0, sizeof(struct io_uring_sqe));
+	sqe->opcode = uring->isRegistered ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+	sqe->fd = writer->descriptor;
+	sqe->addr = (uint64_t)(uintptr_t)writer->buffers[index];
+	sqe->len = length;
+	sqe->off = writer->fileOffset;
+	sqe->buf_index = (uint16_t)index;
+	sqe->user_data = index;
+	uring->sqArray[sqIndex] = sqIndex;
+
+	writer->bufferOffsets[index] = writer->fileOffset;
+	writer->isPending[index] = true;
+	writer->fileOffset += length;
+	__atomic_store_n(uring->sqTail, tail + 1, __ATOMIC_RELEASE);
+
+	if (syscall(__NR_io_uring_enter, uring->ringFile, 1, 0, 0, NULL, 0) != 1)
+	{
+		// Note: Failed to submit, so writing the same data synchronously.
+		__atomic_store_n(uring->sqTail, tail, __ATOMIC_RELEASE);
+		writer->isPending[index] = false;
+		if (!writeAllDataAt(writer->descriptor, writer->buffers[index], length, (off_t)writer->bufferOffsets[index]))
+			writer->failCount++;
+	}
+
+	// Note: Switching to the next buffer, while the kernel writes the current one.
+	writer->bufferIndex = (index + 1) % URING_BUFFER_COUNT;
+	waitUringBuffer(writer, writer->bufferIndex);
+	writer->bufferLengths[writer->bufferIndex] = 0;
+}
+static void writeUringData(LogWriter writer, const char* data, size_t length)
+{
+	assert(writer);
+	assert(data);
+
+	if (length > URING_BUFFER_SIZE)
+	{
+		submitUringBuffer(writer);
+		completeUringWrites(writer, true);
+
+		off_t fileOffset = (off_t)writer->fileOffset;
+		writer->fileOffset += length;
+		if (!writeAllDataAt(writer->descriptor, data, length, fileOffset))
+			writer->failCount++;
+		return;
+	}
+
+	uint32_t index = writer->bufferIndex;
+	if (writer->bufferLengths[index] + length > URING_BUFFER_SIZE)
+	{
+		submitUringBuffer(writer);
+		index = writer->bufferIndex;
+	}
+
+	memcpy(writer->buffers[index] + writer->bufferLengths[index], data, length);
+	writer->bufferLengths[index] += (uint32_t)length;
+}
+#endif
+
+//**********************************************************************************************************************
+#if LOGY_DIRECT_SUPPORT
+static void writeDirectBuffer(LogWriter writer, size_t length)
+{
+	assert(writer);
+	assert(length % DIRECT_BLOCK_SIZE == 0);
+
+	uint64_t endOffset = writer->directOffset + length;
+	if (endOffset > writer->allocatedSize)
+	{
+		// Note: Preallocating file space with large extents to reduce fragmentation.
+		uint64_t allocatedSize = endOffset + DIRECT_EXTENT_SIZE - endOffset % DIRECT_EXTENT_SIZE;
+		if (fallocate(writer->descriptor, FALLOC_FL_KEEP_SIZE, writer->allocatedSize,
+			(off_t)(allocatedSize - writer->allocatedSize)) != 0)
+		{
+			allocatedSize = UINT64_MAX; // Note: Not supported or no space, writing without preallocation.
+		}
+		writer->allocatedSize = allocatedSize;
+	}
+
+	if (!writeAllDataAt(writer->descriptor, writer->directBuffer, length, (off_t)writer->directOffset))
+		writer->failCount++;
+}
+static void writeDirectData(LogWriter writer, const char* data, size_t length)
+{
+	assert(writer);
+	assert(data);
+
+	while (length > 0)
+	{
+		size_t count = DIRECT_BUFFER_SIZE - writer->directLength;
+		if (count > length)
+			count = length;
+
+		memcpy(writer->directBuffer + writer->directLength, data, count);
+		writer->directLength += count;
+		data += count; length -= count;
+
+		if (writer->directLength == DIRECT_BUFFER_SIZE)
+		{
+			writeDirectBuffer(writer, DIRECT_BUFFER_SIZE);
+			writer->directOffset += DIRECT_BUFFER_SIZE;
+			writer->directLength = 0;
+		}
+	}
+}
+static void flushDirectData(LogWriter writer)
+{
+	assert(writer);
+
+	size_t length = writer->directLength;
+	if (length == 0) return;
+
+	// Note: Writing the last partial block padded with zeros, it will be overwritten by the next flush.
+	size_t alignedLength = (length + DIRECT_BLOCK_SIZE - 1) & ~(size_t)(DIRECT_BLOCK_SIZE - 1);
+	memset(writer->directBuffer + length, 0, alignedLength - length);
+	writeDirectBuffer(writer, alignedLength);
+
+	size_t blockLength = length & ~(size_t)(DIRECT_BLOCK_SIZE - 1);
+	if (blockLength > 0)
+	{
+		memmove(writer->directBuffer, writer->directBuffer + blockLength, length - blockLength);
+		writer->directOffset += blockLength;
+		writer->directLength = length - blockLength;
+	}
+}
+static bool openDirectFile(LogWriter writer, const char* filePath, bool append)
+{
+	assert(writer);
+	assert(filePath);
+
+	int descriptor = open(filePath, O_WRONLY | O_CREAT | O_DIRECT | O_CLOEXEC | (append ? 0 : O_TRUNC), 0644);
+	if (descriptor < 0)
+		return false; // Note: Some file systems (tmpfs) do not support direct I/O.
+
+	char* buffer = allocateWriterBuffer(DIRECT_BUFFER_SIZE);
+	if (!buffer)
+	{
+		close(descriptor);
+		return false;
+	}
+
+	off_t fileSize = lseek(descriptor, 0, SEEK_END);
+	if (fileSize < 0)
+		fileSize = 0;
+
+	uint64_t directOffset = (uint64_t)fileSize & ~(uint64_t)(DIRECT_BLOCK_SIZE - 1);
+	size_t directLength = (size_t)(fileSize - directOffset);
+
+	char* block = NULL;
+	if (directLength > 0)
+	{
+		// Note: Reading existing partial block to continue appending after it. It is read to the separate block,
+		//       which is copied to the buffer on the first write, so the buffer is not touched by this thread.
+		block = malloc(directLength);
+		int readDescriptor = block ? open(filePath, O_RDONLY | O_CLOEXEC) : -1;
+		if (readDescriptor < 0 || pread(readDescriptor, block,
+			directLength, (off_t)directOffset) != (ssize_t)directLength)
+		{
+			if (readDescriptor >= 0) close(readDescriptor);
+			free(block);
+			freeWriterBuffer(buffer, DIRECT_BUFFER_SIZE);
+			close(descriptor);
+			return false;
+		}
+		close(readDescriptor);
+	}
+
+	writer->descriptor = descriptor;
+	writer->directBuffer = buffer;
+	writer->directBlock = block;
+	writer->directOffset = directOffset;
+	writer->directLength = directLength;
+	writer->allocatedSize = directOffset;
+	writer->type = DIRECT_LOG_WRITER_TYPE;
+	return true;
+}
+static void prepareDirectBuffer(LogWriter writer)
+{
+	assert(writer);
+	if (!writer->directBlock)
+		return;
+
+	memcpy(writer->directBuffer, writer->directBlock, writer->directLength);
+	free(writer->directBlock);
+	writer->directBlock = NULL;
+}
+static bool closeDirectFile(LogWriter writer)
+{
+	assert(writer);
+	prepareDirectBuffer(writer);
+	flushDirectData(writer);
+
+	// Note: Cutting off the zero padding and unused preallocated extent space.
+	int result = ftruncate(writer->descriptor, (off_t)(writer->directOffset + writer->directLength));
+	freeWriterBuffer(writer->directBuffer, DIRECT_BUFFER_SIZE);
+	return result == 0;
+}
+#endif
+
+//**********************************************************************************************************************
+LogWriter createLogWriter(LogWriterType type, const char* filePath, bool append)
+{
+	assert(type < LOG_WRITER_TYPE_COUNT);
+	assert(filePath);
+
+	LogWriter writer = calloc(1, sizeof(LogWriter_T));
+	if (!writer) return NULL;
+
+	writer->descriptor = -1;
+
+	#if LOGY_DIRECT_SUPPORT
+	if (type == DIRECT_LOG_WRITER_TYPE)
+	{
+		if (openDirectFile(writer, filePath, append))
+			return writer;
+		type = VECTORED_LOG_WRITER_TYPE;
+	}
+	#else
+	if (type == DIRECT_LOG_WRITER_TYPE)
+		type = VECTORED_LOG_WRITER_TYPE;
+	#endif
+	#if !LOGY_IO_URING_SUPPORT
+	if (type == IO_URING_LOG_WRITER_TYPE)
+		type = VECTORED_LOG_WRITER_TYPE;
+	#endif
+	#if !LOGY_VECTORED_SUPPORT
+	if (type == VECTORED_LOG_WRITER_TYPE)
+		type = STDIO_LOG_WRITER_TYPE;
+	#endif
+
+	if (type == STDIO_LOG_WRITER_TYPE)
+	{
+		FILE* file = openFile(filePath, append ? "a" : "w");
+		if (!file)
+		{
+			free(writer);
+			return NULL;
+		}
+
+		writer->file = file;
+		writer->type = type;
+		return writer;
+	}
+
+	#if LOGY_VECTORED_SUPPORT
+	int flags = O_WRONLY | O_CREAT | O_CLOEXEC;
+	if (type == VECTORED_LOG_WRITER_TYPE)
+		flags |= append ? O_APPEND : O_TRUNC;
+	else if (!append)
+		flags |= O_TRUNC;
+
+	int descriptor = open(filePath, flags, 0644);
+	if (descriptor < 0)
+	{
+		free(writer);
+		return NULL;
+	}
+	writer->descriptor = descriptor;
+	writer->type = VECTORED_LOG_WRITER_TYPE;
+	#endif
+
+	#if LOGY_IO_URING_SUPPORT
+	if (type == IO_URING_LOG_WRITER_TYPE)
+	{
+		bool isCreated = true;
+		for (uint32_t i = 0; i < URING_BUFFER_COUNT; i++)
+		{
+			char* buffer = allocateWriterBuffer(URING_BUFFER_SIZE);
+			if (!buffer)
+			{
+				isCreated = false;
+				break;
+			}
+			writer->buffers[i] = buffer;
+		}
+
+		UringQueue* uring = isCreated ? createUringQueue() : NULL;
+		if (uring)
+		{
+			off_t fileOffset = lseek(descriptor, 0, SEEK_END);
+			writer->fileOffset = fileOffset > 0 ? (uint64_t)fileOffset : 0;
+			writer->uring = uring;
+			writer->type = IO_URING_LOG_WRITER_TYPE;
+		}
+		else
+		{
+			// Note: Falling back to the vectored writer, reopening file in the append mode.
+			for (uint32_t i = 0; i < URING_BUFFER_COUNT; i++)
+			{
+				freeWriterBuffer(writer->buffers[i], URING_BUFFER_SIZE);
+				writer->buffers[i] = NULL;
+			}
+			fcntl(descriptor, F_SETFL, fcntl(descriptor, F_GETFL) | O_APPEND);
+		}
+	}
+	#endif
+
+	return writer;
+}
+bool destroyLogWriter(LogWriter writer)
+{
+	if (!writer) return true;
+	bool isClosed = true;
+
+	#if LOGY_IO_URING_SUPPORT
+	if (writer->uring)
+	{
+		submitUringBuffer(writer);
+		completeUringWrites(writer, true);
+		destroyUringQueue(writer->uring);
+	}
+	for (uint32_t i = 0; i < URING_BUFFER_COUNT; i++)
+		freeWriterBuffer(writer->buffers[i], URING_BUFFER_SIZE);
+	#endif
+
+	#if LOGY_DIRECT_SUPPORT
+	if (writer->directBuffer)
+		isClosed = closeDirectFile(writer);
+	#endif
+
+	#if LOGY_VECTORED_SUPPORT
+	if (writer->descriptor >= 0)
+		close(writer->descriptor);
+	#endif
+
+	if (writer->file)
+		closeFile(writer->file);
+	free(writer);
+	return isClosed;
+}
+
+LogWriterType getLogWriterType(LogWriter writer)
+{
+	assert(writer);
+	return writer->type;
+}
+
+//**********************************************************************************************************************
+static void flushStdioFile(LogWriter writer)
+{
+	// Note: Stdio buffers the data, so failed writes are reported by the flush or the error flag.
+	FILE* file = writer->file;
+	if (fflush(file) != 0 || ferror(file))
+	{
+		clearerr(file);
+		writer->failCount++;
+	}
+}
+
+uint32_t writeLogData(LogWriter writer, const char* data, size_t length)
+{
+	assert(writer);
+	assert(data);
+
+	// Note: Direct writer is used only with the backend, which batches records, see the writeLogRecords().
+	assert(writer->type != DIRECT_LOG_WRITER_TYPE);
+
+	switch (writer->type)
+	{
+	#if LOGY_IO_URING_SUPPORT
+	case IO_URING_LOG_WRITER_TYPE:
+		writeUringData(writer, data, length);
+		submitUringBuffer(writer);
+		break;
+	#endif
+	#if LOGY_VECTORED_SUPPORT
+	case VECTORED_LOG_WRITER_TYPE:
+		if (!writeAllData(writer->descriptor, data, length))
+			writer->failCount++;
+		break;
+	#endif
+	default:
+		fwrite(data, sizeof(char), length, writer->file);
+		flushStdioFile(writer);
+		break;
+	}
+
+	uint32_t failCount = writer->failCount;
+	writer->failCount = 0;
+	return failCount;
+}
+uint32_t writeLogRecords(LogWriter writer, LogRecord* records)
+{
+	assert(writer);
+
+	switch (writer->type)
+	{
+	#if LOGY_DIRECT_SUPPORT
+	case DIRECT_LOG_WRITER_TYPE:
+		prepareDirectBuffer(writer);
+		while (records)
+		{
+			LogRecord* next = records->next;
+			writeDirectData(writer, records->data, records->length);
+			releaseLogRecord(records);
+			records = next;
+		}
+		flushDirectData(writer);
+		break;
+	#endif
+	#if LOGY_IO_URING_SUPPORT
+	case IO_URING_LOG_WRITER_TYPE:
+		while (records)
+		{
+			LogRecord* next = records->next;
+			writeUringData(writer, records->data, records->length);
+			releaseLogRecord(records);
+			records = next;
+		}
+		submitUringBuffer(writer);
+		break;
+	#endif
+	#if LOGY_VECTORED_SUPPORT
+	case VECTORED_LOG_WRITER_TYPE:
+	{
+		struct iovec vectors[IOV_MAX < 1024 ? IOV_MAX : 1024];
+		const int maxVectorCount = (int)(sizeof(vectors) / sizeof(struct iovec));
+
+		while (records)
+		{
+			LogRecord* batch = records;
+			int vectorCount = 0;
+
+			while (records && vectorCount < maxVectorCount)
+			{
+				vectors[vectorCount].iov_base = records->data;
+				vectors[vectorCount].iov_len = records->length;
+				records = records->next;
+				vectorCount++;
+			}
+
+			if (!writeAllVectors(writer->descriptor, vectors, vectorCount))
+				writer->failCount++;
+
+			while (batch != records)
+			{
+				LogRecord* next = batch->next;
+				releaseLogRecord(batch);
+				batch = next;
+			}
+		}
+		break;
+	}
+	#endif
+	default:
+		while (records)
+		{
+			LogRecord* next = records->next;
+			fwrite(records->data, sizeof(char), records->length, writer->file);
+			releaseLogRecord(records);
+			records = next;
+		}
+		flushStdioFile(writer);
+		break;
+	}
+
+	uint32_t failCount = writer->failCount;
+	writer->failCount = 0;
+	return failCount;
+}
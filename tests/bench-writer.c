@@ -0,0 +1,202 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "logy/logger.h"
+#include "logy/backend.h"
+#include "mpmt/thread.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Note: Compares log file writers by the message call latency and by the page cache footprint
+//       of the written log file, which is counted with mincore() after the logger is destroyed.
+//       Usage: BenchLogyWriter [message count]
+
+#define BENCH_DIRECTORY_PATH "logy-bench-writer"
+#define DEFAULT_BENCH_MESSAGE_COUNT 200000
+
+typedef struct BenchCase
+{
+	const char* name;
+	LogWriterType writerType;
+	bool useBackend;
+} BenchCase;
+
+typedef struct BenchResult
+{
+	double p50;
+	double p99;
+	double maxLatency;
+	double totalTime;
+	size_t fileSize;
+	size_t residentSize;
+	LogWriterType writerType;
+} BenchResult;
+
+static const char* const writerTypeNames[LOG_WRITER_TYPE_COUNT] =
+{
+	"stdio", "vectored", "io_uring", "direct",
+};
+
+//**********************************************************************************************************************
+static int compareLatencies(const void* a, const void* b)
+{
+	double latencyA = *(const double*)a, latencyB = *(const double*)b;
+	return latencyA < latencyB ? -1 : (latencyA > latencyB ? 1 : 0);
+}
+static bool getResidentSize(const char* filePath, size_t* fileSize, size_t* residentSize)
+{
+	int file = open(filePath, O_RDONLY);
+	if (file < 0)
+		return false;
+
+	struct stat fileStat;
+	if (fstat(file, &fileStat) != 0)
+	{
+		close(file);
+		return false;
+	}
+
+	*fileSize = (size_t)fileStat.st_size;
+	*residentSize = 0;
+	if (fileStat.st_size == 0)
+	{
+		close(file);
+		return true;
+	}
+
+	size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+	size_t pageCount = (*fileSize + pageSize - 1) / pageSize;
+	void* memory = mmap(NULL, *fileSize, PROT_READ, MAP_SHARED, file, 0);
+	close(file);
+
+	if (memory == MAP_FAILED)
+		return false;
+
+	// Note: Mapping the file does not load its pages, mincore() reports only the cached ones.
+	#if __APPLE__
+	char* pages = malloc(pageCount);
+	#else
+	unsigned char* pages = malloc(pageCount);
+	#endif
+
+	bool result = pages && mincore(memory, *fileSize, pages) == 0;
+	if (result)
+	{
+		for (size_t i = 0; i < pageCount; i++)
+		{
+			if (pages[i] & 1)
+				*residentSize += pageSize;
+		}
+	}
+
+	free(pages);
+	munmap(memory, *fileSize);
+	return result;
+}
+
+//**********************************************************************************************************************
+static bool runBenchCase(const BenchCase* benchCase, uint32_t messageCount, double* latencies, BenchResult* result)
+{
+	char directoryPath[128];
+	char filePath[256];
+	snprintf(directoryPath, sizeof(directoryPath), BENCH_DIRECTORY_PATH "/%s", benchCase->name);
+	snprintf(filePath, sizeof(filePath), "%s/" SOLO_LOG_FILE_NAME, directoryPath);
+	remove(filePath);
+
+	LogBackend backend = NULL;
+	if (benchCase->useBackend && createLogBackend(0, &backend) != SUCCESS_LOGY_RESULT)
+		return false;
+
+	LoggerOptions options = getDefaultLoggerOptions();
+	options.writerType = benchCase->writerType;
+	options.backend = backend;
+	options.backendQueueCapacity = 0;
+
+	Logger logger;
+	if (createLoggerExt(directoryPath, INFO_LOG_LEVEL, false, 0.0, false, &options, &logger) != SUCCESS_LOGY_RESULT)
+	{
+		destroyLogBackend(backend);
+		return false;
+	}
+	result->writerType = getLoggerWriterType(logger);
+
+	static const char padding[] = "padding padding padding padding padding padding padding padding";
+	double beginTime = getCurrentClock();
+
+	for (uint32_t i = 0; i < messageCount; i++)
+	{
+		double messageTime = getCurrentClock();
+		logMessage(logger, INFO_LOG_LEVEL, "Benchmark message %u %s", i, padding);
+		latencies[i] = getCurrentClock() - messageTime;
+	}
+
+	destroyLogger(logger);
+	destroyLogBackend(backend);
+	result->totalTime = getCurrentClock() - beginTime;
+
+	qsort(latencies, messageCount, sizeof(double), compareLatencies);
+	result->p50 = latencies[messageCount / 2];
+	result->p99 = latencies[(size_t)messageCount * 99 / 100];
+	result->maxLatency = latencies[messageCount - 1];
+	return getResidentSize(filePath, &result->fileSize, &result->residentSize);
+}
+
+int main(int argc, char** argv)
+{
+	uint32_t messageCount = argc > 1 ? (uint32_t)strtoul(argv[1], NULL, 10) : DEFAULT_BENCH_MESSAGE_COUNT;
+	if (messageCount == 0)
+		return EXIT_FAILURE;
+
+	double* latencies = malloc(messageCount * sizeof(double));
+	if (!latencies)
+		return EXIT_FAILURE;
+	mkdir(BENCH_DIRECTORY_PATH, 0755);
+
+	static const BenchCase benchCases[] =
+	{
+		{ "stdio", STDIO_LOG_WRITER_TYPE, false },
+		{ "stdio-backend", STDIO_LOG_WRITER_TYPE, true },
+		{ "vectored-backend", VECTORED_LOG_WRITER_TYPE, true },
+		{ "direct-backend", DIRECT_LOG_WRITER_TYPE, true },
+	};
+
+	printf("%-18s %-9s %10s %10s %10s %10s %12s %12s\n", "case", "writer",
+		"p50 (us)", "p99 (us)", "max (us)", "total (s)", "file (KiB)", "cached (KiB)");
+
+	bool isSucceeded = true;
+	for (size_t i = 0; i < sizeof(benchCases) / sizeof(BenchCase); i++)
+	{
+		const BenchCase* benchCase = &benchCases[i];
+		BenchResult result;
+		if (!runBenchCase(benchCase, messageCount, latencies, &result))
+		{
+			printf("%-18s failed\n", benchCase->name);
+			isSucceeded = false;
+			continue;
+		}
+
+		printf("%-18s %-9s %10.2f %10.2f %10.2f %10.3f %12zu %12zu\n", benchCase->name,
+			writerTypeNames[result.writerType], result.p50 * 1000000.0, result.p99 * 1000000.0,
+			result.maxLatency * 1000000.0, result.totalTime, result.fileSize / 1024, result.residentSize / 1024);
+	}
+
+	free(latencies);
+	return isSucceeded ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,122 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "logy/deferred.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+// Note: Deferred strings are placed right before an inaccessible page, so reading past them crashes the test.
+
+#define TEST_DIRECTORY_PATH "logy-test-deferred"
+#define TEST_LOG_PATH TEST_DIRECTORY_PATH "/" SOLO_LOG_FILE_NAME
+#define TEST_STRING "precision"
+#define TEST_STRING_LENGTH 9
+
+static char* createGuardedString(char** page, size_t* pageSize)
+{
+	size_t size = (size_t)sysconf(_SC_PAGESIZE);
+	char* memory = mmap(NULL, size * 2, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (memory == MAP_FAILED)
+		return NULL;
+
+	if (mprotect(memory + size, size, PROT_NONE) != 0)
+	{
+		munmap(memory, size * 2);
+		return NULL;
+	}
+
+	char* string = memory + size - TEST_STRING_LENGTH;
+	memcpy(string, TEST_STRING, TEST_STRING_LENGTH); // Note: Without the null terminator.
+	*page = memory;
+	*pageSize = size;
+	return string;
+}
+static bool readTestLog(char* data, size_t size)
+{
+	FILE* file = fopen(TEST_LOG_PATH, "rb");
+	if (!file)
+		return false;
+	size_t length = fread(data, sizeof(char), size - 1, file);
+	data[length] = '\0';
+	fclose(file);
+	return true;
+}
+
+//**********************************************************************************************************************
+static bool testDeferredPrecision()
+{
+	char* page; size_t pageSize;
+	const char* string = createGuardedString(&page, &pageSize);
+	if (!string)
+	{
+		printf("testDeferredPrecision: failed to map guarded string.\n");
+		return false;
+	}
+
+	remove(TEST_LOG_PATH);
+
+	Logger logger;
+	if (createLogger(TEST_DIRECTORY_PATH, INFO_LOG_LEVEL, false, 0.0, false, &logger) != SUCCESS_LOGY_RESULT)
+	{
+		printf("testDeferredPrecision: failed to create logger.\n");
+		munmap(page, pageSize * 2);
+		return false;
+	}
+
+	if (beginLogDeferral(logger, DEBUG_LOG_LEVEL, DEFAULT_LOG_DEFERRAL_BUFFER_SIZE) != SUCCESS_LOGY_RESULT)
+	{
+		printf("testDeferredPrecision: failed to begin deferral.\n");
+		destroyLogger(logger);
+		munmap(page, pageSize * 2);
+		return false;
+	}
+
+	logMessage(logger, DEBUG_LOG_LEVEL, "star [%.*s]", TEST_STRING_LENGTH, string);
+	logMessage(logger, DEBUG_LOG_LEVEL, "digits [%.9s]", string);
+	logMessage(logger, DEBUG_LOG_LEVEL, "short [%.4s]", string);
+	logMessage(logger, DEBUG_LOG_LEVEL, "width [%12.*s]", 3, string);
+	failLogDeferral();
+	endLogDeferral();
+	destroyLogger(logger);
+	munmap(page, pageSize * 2);
+
+	char log[4096];
+	if (!readTestLog(log, sizeof(log)))
+	{
+		printf("testDeferredPrecision: failed to read log file.\n");
+		return false;
+	}
+
+	const char* expected[] = { "star [precision]", "digits [precision]", "short [prec]", "width [         pre]" };
+	for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++)
+	{
+		if (!strstr(log, expected[i]))
+		{
+			printf("testDeferredPrecision: expected \"%s\" in log:\n%s", expected[i], log);
+			return false;
+		}
+	}
+	return true;
+}
+
+int main()
+{
+	if (!testDeferredPrecision())
+		return EXIT_FAILURE;
+	return EXIT_SUCCESS;
+}
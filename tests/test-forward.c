@@ -0,0 +1,260 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "logy/forward.h"
+#include "mpmt/thread.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+// Note: Stand-in local agent, which receives syslog records over a stream socket with octet counting framing.
+
+#define TEST_DIRECTORY_PATH "logy-test-forward"
+#define TEST_SOCKET_PATH TEST_DIRECTORY_PATH "/agent.sock"
+#define TEST_SPOOL_PATH TEST_DIRECTORY_PATH "/" LOG_FORWARD_SPOOL_FILE_NAME
+#define TEST_RECEIVE_TIMEOUT 5.0
+#define TEST_BACKLOG_COUNT 20000
+
+static int listenAgent()
+{
+	unlink(TEST_SOCKET_PATH);
+	int agent = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (agent < 0) return -1;
+
+	struct sockaddr_un address;
+	memset(&address, 0, sizeof(struct sockaddr_un));
+	address.sun_family = AF_UNIX;
+	memcpy(address.sun_path, TEST_SOCKET_PATH, strlen(TEST_SOCKET_PATH));
+
+	if (bind(agent, (struct sockaddr*)&address, sizeof(struct sockaddr_un)) != 0 || listen(agent, 4) != 0)
+	{
+		close(agent);
+		return -1;
+	}
+	return agent;
+}
+static int acceptAgent(int agent)
+{
+	int client = accept(agent, NULL, NULL);
+	if (client < 0) return -1;
+
+	struct timeval timeout;
+	timeout.tv_sec = 0;
+	timeout.tv_usec = 100000;
+	setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(struct timeval));
+	return client;
+}
+static Logger createTestLogger()
+{
+	LoggerOptions options = getDefaultLoggerOptions();
+	options.forwardSocketPath = TEST_SOCKET_PATH;
+	options.forwardType = STREAM_LOG_FORWARD_TYPE;
+	options.forwardSyslog = true;
+
+	Logger logger;
+	if (createLoggerExt(TEST_DIRECTORY_PATH, INFO_LOG_LEVEL, false, 0.0, false, &options, &logger) != SUCCESS_LOGY_RESULT)
+		return NULL;
+	return logger;
+}
+static void logTestMessages(Logger logger, int begin, int end)
+{
+	// Note: Padding fills the agent socket buffer faster in the slow agent test.
+	static const char padding[] = "padding padding padding padding padding padding padding padding padding";
+	for (int i = begin; i < end; i++)
+	{
+		logMessage(logger, INFO_LOG_LEVEL, "%s message %d", padding, i);
+		if (i % 1000 == 999)
+			sleepThread(0.01);
+	}
+}
+
+//**********************************************************************************************************************
+// Note: Negative end index receives frames until the connection is closed.
+static bool receiveFrames(int client, int* nextIndex, int endIndex)
+{
+	static char buffer[1024 * 1024];
+	size_t size = 0;
+	double timeout = getCurrentClock() + TEST_RECEIVE_TIMEOUT;
+
+	while (endIndex < 0 || *nextIndex < endIndex)
+	{
+		if (getCurrentClock() > timeout)
+		{
+			printf("receiveFrames: timed out at %d of %d.\n", *nextIndex, endIndex);
+			return false;
+		}
+
+		ssize_t count = recv(client, buffer + size, sizeof(buffer) - size - 1, 0);
+		if (count == 0 && endIndex < 0)
+			return true; // Note: Logger closed the connection.
+		if (count <= 0) continue;
+		size += (size_t)count;
+
+		// Note: RFC 6587 octet counting: "MSG-LEN SP SYSLOG-MSG", without trailer.
+		size_t offset = 0;
+		while (offset < size)
+		{
+			char* end = memchr(buffer + offset, ' ', size - offset);
+			if (!end) break;
+
+			char* lengthEnd;
+			unsigned long length = strtoul(buffer + offset, &lengthEnd, 10);
+			if (lengthEnd != end || length == 0 || buffer[offset] < '1' || buffer[offset] > '9')
+			{
+				printf("receiveFrames: bad frame length at %d.\n", *nextIndex);
+				return false;
+			}
+
+			size_t frameBegin = (size_t)(end - buffer) + 1;
+			if (frameBegin + length > size) break;
+
+			char* frame = buffer + frameBegin;
+			char saved = frame[length];
+			frame[length] = '\0';
+
+			char expected[32];
+			snprintf(expected, sizeof(expected), " message %d", *nextIndex);
+			size_t expectedLength = strlen(expected);
+
+			if (strncmp(frame, "<14>1 ", 6) != 0 || length < expectedLength ||
+				strcmp(frame + length - expectedLength, expected) != 0)
+			{
+				printf("receiveFrames: expected message %d, received \"%s\".\n", *nextIndex, frame);
+				return false;
+			}
+
+			frame[length] = saved;
+			offset = frameBegin + length;
+			(*nextIndex)++;
+		}
+
+		memmove(buffer, buffer + offset, size - offset);
+		size -= offset;
+	}
+	return true;
+}
+
+//**********************************************************************************************************************
+static bool testForwardSpoolReplay()
+{
+	remove(TEST_SPOOL_PATH);
+	unlink(TEST_SOCKET_PATH);
+
+	Logger logger = createTestLogger();
+	if (!logger)
+	{
+		printf("testForwardSpoolReplay: failed to create logger.\n");
+		return false;
+	}
+
+	// Note: Agent is down, records are spooled.
+	logTestMessages(logger, 0, 50);
+	sleepThread(0.1);
+
+	if (isLoggerForwardConnected(logger))
+	{
+		printf("testForwardSpoolReplay: connected without agent.\n");
+		destroyLogger(logger);
+		return false;
+	}
+
+	// Note: Agent is up, spooled records are replayed before the new ones.
+	int agent = listenAgent();
+	if (agent < 0)
+	{
+		printf("testForwardSpoolReplay: failed to listen agent socket.\n");
+		destroyLogger(logger);
+		return false;
+	}
+
+	sleepThread(1.5);
+	logTestMessages(logger, 50, 100);
+
+	int client = acceptAgent(agent);
+	int nextIndex = 0;
+	bool isReceived = client >= 0 && receiveFrames(client, &nextIndex, 100);
+
+	if (isReceived && !isLoggerForwardConnected(logger))
+	{
+		printf("testForwardSpoolReplay: not connected to agent.\n");
+		isReceived = false;
+	}
+
+	// Note: Agent is slow, unsent records are kept in the spool for the next run.
+	const int backlogEnd = 100 + TEST_BACKLOG_COUNT;
+	logTestMessages(logger, 100, backlogEnd);
+	sleepThread(0.1);
+	destroyLogger(logger);
+
+	if (isReceived)
+		isReceived = receiveFrames(client, &nextIndex, -1);
+	if (client >= 0) close(client);
+	close(agent);
+	unlink(TEST_SOCKET_PATH);
+
+	if (!isReceived)
+		return false;
+	if (nextIndex >= backlogEnd)
+	{
+		printf("testForwardSpoolReplay: agent received all records, nothing was spooled.\n");
+		return false;
+	}
+
+	agent = listenAgent();
+	if (agent < 0)
+	{
+		printf("testForwardSpoolReplay: failed to listen agent socket.\n");
+		return false;
+	}
+
+	logger = createTestLogger();
+	if (!logger)
+	{
+		printf("testForwardSpoolReplay: failed to create logger.\n");
+		close(agent);
+		return false;
+	}
+
+	logTestMessages(logger, backlogEnd, backlogEnd + 50);
+
+	client = acceptAgent(agent);
+	isReceived = client >= 0 && receiveFrames(client, &nextIndex, backlogEnd + 50);
+	uint64_t dropCount = getLoggerForwardDropCount(logger);
+
+	destroyLogger(logger);
+	if (client >= 0) close(client);
+	close(agent);
+	unlink(TEST_SOCKET_PATH);
+
+	if (!isReceived)
+		return false;
+	if (dropCount != 0)
+	{
+		printf("testForwardSpoolReplay: dropped %llu records after restart.\n", (unsigned long long)dropCount);
+		return false;
+	}
+	return true;
+}
+
+int main()
+{
+	if (!testForwardSpoolReplay())
+		return EXIT_FAILURE;
+	return EXIT_SUCCESS;
+}
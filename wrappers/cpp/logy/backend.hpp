@@ -0,0 +1,114 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Shared logger backend.
+ * @details See the @ref backend.h
+ */
+
+#pragma once
+#include "logy/error.hpp"
+#include <utility>
+
+extern "C"
+{
+#include "logy/backend.h"
+}
+
+namespace logy
+{
+
+/**
+ * @brief Shared log backend instance handle.
+ * @details See the @ref backend.h
+ */
+class LogBackend final
+{
+	LogBackend_T* instance = nullptr;
+public:
+	/**
+	 * @brief Creates a new empty log backend handle.
+	 */
+	LogBackend() = default;
+
+	LogBackend(const LogBackend&) = delete;
+	LogBackend(LogBackend&& r) noexcept : instance(std::exchange(r.instance, nullptr)) { }
+
+	LogBackend& operator=(LogBackend&) = delete;
+	LogBackend& operator=(LogBackend&& r) noexcept
+	{
+		instance = std::exchange(r.instance, nullptr);
+		return *this;
+	}
+
+	/*******************************************************************************************************************
+	 * @brief Creates a new log backend instance.
+	 * @details See the @ref createLogBackend().
+	 * @param compressionThreadCount rotated log file compression thread count, or 0 to compress on I/O thread
+	 * @throw Error with a @ref LogyResult string on failure.
+	 */
+	explicit LogBackend(uint32_t compressionThreadCount)
+	{
+		auto result = createLogBackend(compressionThreadCount, &instance);
+		if (result != SUCCESS_LOGY_RESULT)
+			throw Error(logyResultToString(result));
+	}
+	/**
+	 * @brief Creates a new log backend instance with thread placement options.
+	 * @details See the @ref createLogBackendExt().
+	 *
+	 * @param compressionThreadCount rotated log file compression thread count, or 0 to compress on I/O thread
+	 * @param[in] threadOptions backend thread placement options
+	 *
+	 * @throw Error with a @ref LogyResult string on failure.
+	 */
+	LogBackend(uint32_t compressionThreadCount, const LogThreadOptions& threadOptions)
+	{
+		auto result = createLogBackendExt(compressionThreadCount, &threadOptions, &instance);
+		if (result != SUCCESS_LOGY_RESULT)
+			throw Error(logyResultToString(result));
+	}
+
+	/**
+	 * @brief Destroys log backend instance.
+	 * @details See the @ref destroyLogBackend().
+	 */
+	~LogBackend() { destroyLogBackend(instance); }
+
+	/**
+	 * @brief Returns log backend C instance or nullptr.
+	 */
+	LogBackend_T* getInstance() const noexcept { return instance; }
+
+	/*******************************************************************************************************************
+	 * @brief Returns log backend compression thread count. (MT-Safe)
+	 * @details See the @ref getLogBackendCompressionThreadCount().
+	 */
+	uint32_t getCompressionThreadCount() const noexcept
+	{
+		return getLogBackendCompressionThreadCount(instance);
+	}
+
+	/**
+	 * @brief Returns log backend attached logger count. (MT-Safe)
+	 * @details See the @ref getLogBackendLoggerCount().
+	 */
+	size_t getLoggerCount() const noexcept
+	{
+		return getLogBackendLoggerCount(instance);
+	}
+};
+
+} // namespace logy
@@ -0,0 +1,47 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Logging call-site metadata.
+ * @details See the @ref callsite.h
+ */
+
+#pragma once
+#include "logy/logger.hpp"
+
+namespace logy
+{
+
+/**
+ * @brief Returns logger C instance used by the logging macros.
+ * @param[in] logger logger instance
+ */
+static inline Logger_T* getLoggerInstance(Logger_T* logger) noexcept { return logger; }
+/**
+ * @brief Returns logger C instance used by the logging macros.
+ * @param[in] logger logger instance
+ */
+static inline Logger_T* getLoggerInstance(const Logger& logger) noexcept { return logger.getInstance(); }
+
+} // namespace logy
+
+#ifndef LOGY_LOGGER_INSTANCE
+#define LOGY_LOGGER_INSTANCE(logger) logy::getLoggerInstance(logger)
+#endif
+
+extern "C"
+{
+#include "logy/callsite.h"
+}
@@ -0,0 +1,147 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Hierarchical logger categories.
+ * @details See the @ref category.h
+ */
+
+#pragma once
+#include "logy/logger.hpp"
+
+extern "C"
+{
+#include "logy/category.h"
+}
+
+namespace logy
+{
+
+/**
+ * @brief Log category handle.
+ * @details See the @ref category.h
+ * @note Category is owned by the logger, handle should not outlive it.
+ */
+class LogCategory final
+{
+	LogCategory_T* instance = nullptr;
+public:
+	/**
+	 * @brief Creates a new empty log category handle.
+	 */
+	LogCategory() = default;
+
+	/**
+	 * @brief Returns logger category, creates a new one if not exists. (MT-Safe)
+	 * @details See the @ref getLogCategory().
+	 *
+	 * @param[in] logger target logger instance
+	 * @param[in] name dot separated category name string (e.g. "net.http")
+	 *
+	 * @throw Error with a @ref LogyResult string on failure.
+	 */
+	LogCategory(const Logger& logger, const string& name)
+	{
+		auto result = getLogCategory(logger.getInstance(), name.c_str(), &instance);
+		if (result != SUCCESS_LOGY_RESULT)
+			throw Error(logyResultToString(result));
+	}
+
+	/**
+	 * @brief Returns log category C instance or nullptr.
+	 */
+	LogCategory_T* getInstance() const noexcept { return instance; }
+
+	/*******************************************************************************************************************
+	 * @brief Returns log category name string. (MT-Safe)
+	 * @details See the @ref getLogCategoryName().
+	 */
+	string_view getName() const noexcept
+	{
+		return getLogCategoryName(instance);
+	}
+
+	/**
+	 * @brief Returns log category effective logging level. (MT-Safe, Lock-Free)
+	 * @details See the @ref getLogCategoryLevel().
+	 */
+	LogLevel getLevel() const noexcept
+	{
+		return getLogCategoryLevel(instance);
+	}
+
+	/**
+	 * @brief Sets log category logging level. (MT-Safe)
+	 * @details See the @ref setLogCategoryLevel().
+	 * @param level message logging level
+	 */
+	void setLevel(LogLevel level) noexcept
+	{
+		setLogCategoryLevel(instance, level);
+	}
+
+	/**
+	 * @brief Resets log category logging level, to inherit it from the parent. (MT-Safe)
+	 * @details See the @ref resetLogCategoryLevel().
+	 */
+	void resetLevel() noexcept
+	{
+		resetLogCategoryLevel(instance);
+	}
+
+	/**
+	 * @brief Returns true if message with specified level will be logged. (MT-Safe, Lock-Free)
+	 * @details See the @ref isLogCategoryEnabled().
+	 * @param level message logging level
+	 */
+	bool isEnabled(LogLevel level) const noexcept
+	{
+		return isLogCategoryEnabled(instance, level);
+	}
+
+	/**
+	 * @brief Logs category message to the log. (MT-Safe)
+	 * @details See the @ref logCategoryMessageVA().
+	 *
+	 * @param level message logging level
+	 * @param[in] fmt formatted message string
+	 * @param args message arguments
+	 */
+	void log(LogLevel level, const char* fmt, va_list args) noexcept
+	{
+		va_list stdArgs;
+		va_copy(stdArgs, args);
+		logCategoryMessageVA(instance, level, fmt, stdArgs);
+		va_end(stdArgs);
+	}
+
+	/**
+	 * @brief Logs category message to the log. (MT-Safe)
+	 * @details See the @ref logCategoryMessageVA().
+	 *
+	 * @param level message logging level
+	 * @param[in] fmt formatted message string
+	 * @param ... message arguments
+	 */
+	void log(LogLevel level, const char* fmt, ...) noexcept
+	{
+		va_list args;
+		va_start(args, fmt);
+		logCategoryMessageVA(instance, level, fmt, args);
+		va_end(args);
+	}
+};
+
+} // namespace logy
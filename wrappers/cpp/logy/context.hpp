@@ -0,0 +1,166 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Per-thread logging context.
+ * @details See the @ref context.h
+ */
+
+#pragma once
+#include "logy/error.hpp"
+#include <utility>
+#include <string_view>
+
+extern "C"
+{
+#include "logy/context.h"
+}
+
+namespace logy
+{
+
+/**
+ * @brief Thread context key-value pair scope guard.
+ * @details Pushes pair to the calling thread context on construction and pops it on destruction.
+ */
+class LogContextScope final
+{
+public:
+	/**
+	 * @brief Pushes key-value pair to the calling thread context.
+	 * @details See the @ref pushLogContext().
+	 *
+	 * @param[in] key context key string
+	 * @param[in] value context value string
+	 *
+	 * @throw Error with a @ref LogyResult string on failure.
+	 */
+	LogContextScope(const string& key, const string& value)
+	{
+		auto result = pushLogContext(key.c_str(), value.c_str());
+		if (result != SUCCESS_LOGY_RESULT)
+			throw Error(logyResultToString(result));
+	}
+	/**
+	 * @brief Pops key-value pair from the calling thread context.
+	 * @details See the @ref popLogContext().
+	 */
+	~LogContextScope() { popLogContext(); }
+
+	LogContextScope(const LogContextScope&) = delete;
+	LogContextScope& operator=(const LogContextScope&) = delete;
+};
+
+/***********************************************************************************************************************
+ * @brief Captured logging context.
+ * @details See the @ref context.h
+ */
+class LogContext final
+{
+	LogContext_T* instance = nullptr;
+public:
+	/**
+	 * @brief Creates a new empty captured context.
+	 */
+	LogContext() = default;
+
+	/**
+	 * @brief Destroys captured context.
+	 * @details See the @ref destroyLogContext().
+	 */
+	~LogContext() { destroyLogContext(instance); }
+
+	LogContext(const LogContext&) = delete;
+	LogContext(LogContext&& r) noexcept : instance(std::exchange(r.instance, nullptr)) { }
+
+	LogContext& operator=(LogContext&) = delete;
+	LogContext& operator=(LogContext&& r) noexcept
+	{
+		destroyLogContext(instance);
+		instance = std::exchange(r.instance, nullptr);
+		return *this;
+	}
+
+	/**
+	 * @brief Captures calling thread context to transfer it to another thread.
+	 * @details See the @ref captureLogContext().
+	 * @throw Error with a @ref LogyResult string on failure.
+	 */
+	static LogContext capture()
+	{
+		LogContext context;
+		auto result = captureLogContext(&context.instance);
+		if (result != SUCCESS_LOGY_RESULT)
+			throw Error(logyResultToString(result));
+		return context;
+	}
+
+	/**
+	 * @brief Returns captured context C instance or nullptr.
+	 */
+	LogContext_T* getInstance() const noexcept { return instance; }
+
+	/**
+	 * @brief Replaces calling thread context with the captured one.
+	 * @details See the @ref restoreLogContext().
+	 * @throw Error with a @ref LogyResult string on failure.
+	 */
+	void restore() const
+	{
+		auto result = restoreLogContext(instance);
+		if (result != SUCCESS_LOGY_RESULT)
+			throw Error(logyResultToString(result));
+	}
+
+	/*******************************************************************************************************************
+	 * @brief Returns calling thread context key-value pair count.
+	 * @details See the @ref getLogContextSize().
+	 */
+	static uint32_t getSize() noexcept { return getLogContextSize(); }
+
+	/**
+	 * @brief Returns calling thread rendered context prefix string.
+	 * @details See the @ref getLogContextPrefix().
+	 */
+	static string_view getPrefix() noexcept { return getLogContextPrefix(); }
+};
+
+/**
+ * @brief Captured context restore guard, for the asynchronous tasks on the worker threads.
+ * @details Restores captured context on construction and the previous thread context on destruction.
+ */
+class LogContextRestore final
+{
+	LogContext previous;
+public:
+	/**
+	 * @brief Replaces calling thread context with the captured one.
+	 * @param[in] context captured context
+	 * @throw Error with a @ref LogyResult string on failure.
+	 */
+	explicit LogContextRestore(const LogContext& context) : previous(LogContext::capture())
+	{
+		context.restore();
+	}
+	/**
+	 * @brief Restores previous calling thread context.
+	 */
+	~LogContextRestore() { restoreLogContext(previous.getInstance()); }
+
+	LogContextRestore(const LogContextRestore&) = delete;
+	LogContextRestore& operator=(const LogContextRestore&) = delete;
+};
+
+} // namespace logy
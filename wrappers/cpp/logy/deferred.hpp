@@ -0,0 +1,88 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Deferred (tail-based) message logging.
+ * @details See the @ref deferred.h
+ */
+
+#pragma once
+#include "logy/logger.hpp"
+#include <exception>
+
+extern "C"
+{
+#include "logy/deferred.h"
+}
+
+namespace logy
+{
+
+/**
+ * @brief Deferral scope guard.
+ * 
+ * @details
+ * Begins deferral scope on construction and ends it on destruction, see the @ref deferred.h
+ * Scope is marked failed if it is destroyed while an exception is propagating.
+ */
+class LogDeferral final
+{
+	int exceptionCount = 0;
+public:
+	/**
+	 * @brief Begins a new deferral scope on the calling thread.
+	 * @details See the @ref beginLogDeferral().
+	 *
+	 * @param[in] logger target logger instance
+	 * @param level deferred message logging level, inclusive
+	 * @param bufferSize message buffer size in bytes
+	 *
+	 * @throw Error with a @ref LogyResult string on failure.
+	 */
+	LogDeferral(const Logger& logger, LogLevel level = ALL_LOG_LEVEL - 1,
+		size_t bufferSize = DEFAULT_LOG_DEFERRAL_BUFFER_SIZE) : exceptionCount(std::uncaught_exceptions())
+	{
+		auto result = beginLogDeferral(logger.getInstance(), level, bufferSize);
+		if (result != SUCCESS_LOGY_RESULT)
+			throw Error(logyResultToString(result));
+	}
+	/**
+	 * @brief Ends deferral scope.
+	 * @details See the @ref endLogDeferral().
+	 */
+	~LogDeferral()
+	{
+		if (std::uncaught_exceptions() > exceptionCount)
+			failLogDeferral();
+		endLogDeferral();
+	}
+
+	LogDeferral(const LogDeferral&) = delete;
+	LogDeferral& operator=(const LogDeferral&) = delete;
+
+	/**
+	 * @brief Marks deferral scope as failed.
+	 * @details See the @ref failLogDeferral().
+	 */
+	void fail() noexcept { failLogDeferral(); }
+
+	/**
+	 * @brief Returns true if deferral scope is failed.
+	 * @details See the @ref isLogDeferralFailed().
+	 */
+	bool isFailed() const noexcept { return isLogDeferralFailed(); }
+};
+
+} // namespace logy
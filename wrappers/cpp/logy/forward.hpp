@@ -0,0 +1,60 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Local agent log forwarding.
+ * @details See the @ref forward.h
+ */
+
+#pragma once
+#include "logy/logger.hpp"
+
+extern "C"
+{
+#include "logy/forward.h"
+}
+
+namespace logy
+{
+
+/**
+ * @brief Returns true if logger forwards records to the local agent socket. (MT-Safe)
+ * @details See the @ref isLoggerForwarding().
+ * @param[in] logger logger instance
+ */
+static inline bool isForwarding(const Logger& logger) noexcept
+{
+	return isLoggerForwarding(logger.getInstance());
+}
+/**
+ * @brief Returns true if logger is connected to the local agent socket. (MT-Safe)
+ * @details See the @ref isLoggerForwardConnected().
+ * @param[in] logger logger instance
+ */
+static inline bool isForwardConnected(const Logger& logger) noexcept
+{
+	return isLoggerForwardConnected(logger.getInstance());
+}
+/**
+ * @brief Returns dropped forwarded record count. (MT-Safe)
+ * @details See the @ref getLoggerForwardDropCount().
+ * @param[in] logger logger instance
+ */
+static inline uint64_t getForwardDropCount(const Logger& logger) noexcept
+{
+	return getLoggerForwardDropCount(logger.getInstance());
+}
+
+} // namespace logy
@@ -20,6 +20,7 @@
 
 #pragma once
 #include "logy/error.hpp"
+#include "logy/backend.hpp"
 #include <utility>
 #include <filesystem>
 #include <string_view>
@@ -27,6 +28,7 @@
 extern "C"
 {
 #include "logy/logger.h"
+#include "logy/span.h"
 }
 
 namespace logy
@@ -77,6 +79,29 @@ public:
 			throw Error(logyResultToString(result));
 	}
 
+	/**
+	 * @brief Creates a new logger instance with the specified options.
+	 * @details See the @ref createLoggerExt().
+	 *
+	 * @param[in] directoryPath logs directory path string
+	 * @param[in] options logger creation options
+	 * @param level logging level, inclusive
+	 * @param logToStdout duplicate messages to the stdout
+	 * @param rotationTime log rotation delay time or 0 (in seconds)
+	 * @param isAppDataDirectory write to app data directory
+	 * 
+	 * @throw Error with a @ref LogyResult string on failure.
+	 */
+	Logger(const filesystem::path& directoryPath, const LoggerOptions& options, LogLevel level = ALL_LOG_LEVEL,
+		bool logToStdout = true, double rotationTime = 0.0, bool isAppDataDirectory = true)
+	{
+		auto string = directoryPath.generic_string();
+		auto result = createLoggerExt(string.c_str(), level,
+			logToStdout, rotationTime, isAppDataDirectory, &options, &instance);
+		if (result != SUCCESS_LOGY_RESULT)
+			throw Error(logyResultToString(result));
+	}
+
 	/**
 	 * @brief Destroys logger stream.
 	 * @details See the @ref destroyLogger().
@@ -106,6 +131,30 @@ public:
 			throw Error(logyResultToString(result));
 	}
 
+	/**
+	 * @brief Opens a new logger stream with the specified options.
+	 * @details See the @ref createLoggerExt().
+	 *
+	 * @param[in] directoryPath logs directory path string
+	 * @param[in] options logger creation options
+	 * @param level logging level, inclusive
+	 * @param logToStdout duplicate messages to the stdout
+	 * @param rotationTime log rotation delay time or 0 (in seconds)
+	 * @param isAppDataDirectory write to app data directory
+	 * 
+	 * @throw Error with a @ref LogyResult string on failure.
+	 */
+	void open(const filesystem::path& directoryPath, const LoggerOptions& options, LogLevel level = ALL_LOG_LEVEL,
+		bool logToStdout = true, double rotationTime = 0.0, bool isAppDataDirectory = true)
+	{
+		destroyLogger(instance);
+		auto string = directoryPath.generic_string();
+		auto result = createLoggerExt(string.c_str(), level,
+			logToStdout, rotationTime, isAppDataDirectory, &options, &instance);
+		if (result != SUCCESS_LOGY_RESULT)
+			throw Error(logyResultToString(result));
+	}
+
 	/**
 	 * @brief Closes the current logger stream.
 	 * @details See the @ref destroyLogger().
@@ -122,7 +171,46 @@ public:
 	 */
 	bool isOpen() const noexcept { return instance; }
 
+	/**
+	 * @brief Returns logger C instance or nullptr.
+	 */
+	Logger_T* getInstance() const noexcept { return instance; }
+
 	/*******************************************************************************************************************
+	 * @brief Returns logger shared backend instance or NULL. (MT-Safe)
+	 * @details See the @ref getLoggerBackend().
+	 */
+	LogBackend_T* getBackend() const noexcept
+	{
+		return getLoggerBackend(instance);
+	}
+	/**
+	 * @brief Returns logger record count dropped because the backend queue was full. (MT-Safe)
+	 * @details See the @ref getLoggerBackendDropCount().
+	 */
+	uint64_t getBackendDropCount() const noexcept
+	{
+		return getLoggerBackendDropCount(instance);
+	}
+	/**
+	 * @brief Returns logger log file write count, that failed to write all data. (MT-Safe)
+	 * @details See the @ref getLoggerWriteFailCount().
+	 */
+	uint64_t getWriteFailCount() const noexcept
+	{
+		return getLoggerWriteFailCount(instance);
+	}
+
+	/**
+	 * @brief Returns logger file writer type. (MT-Safe)
+	 * @details See the @ref getLoggerWriterType().
+	 */
+	LogWriterType getWriterType() const noexcept
+	{
+		return getLoggerWriterType(instance);
+	}
+
+	/**
 	 * @brief Returns logger directory path string. (MT-Safe)
 	 * @details See the @ref getLoggerDirectoryPath().
 	 */
@@ -218,6 +306,66 @@ public:
 		logMessageVA(instance, level, fmt, args);
 		va_end(args);
 	}
+
+	/**
+	 * @brief Writes all queued logger messages to the log file. (MT-Safe)
+	 * @details See the @ref flushLogger().
+	 */
+	void flush() noexcept
+	{
+		flushLogger(instance);
+	}
+
+	/**
+	 * @brief Returns true if logger writes timing spans to the trace file. (MT-Safe)
+	 * @details See the @ref isLoggerTracing().
+	 */
+	bool isTracing() const noexcept
+	{
+		return isLoggerTracing(instance);
+	}
+};
+
+/***********************************************************************************************************************
+ * @brief Scoped timing span guard.
+ * @details Begins span on construction and ends it on destruction, see the @ref span.h
+ */
+class LogSpan final
+{
+	Logger_T* logger = nullptr;
+	::LogSpan span = {};
+public:
+	/**
+	 * @brief Begins a new timing span. (MT-Safe, Lock-Free)
+	 * @details See the @ref beginLogSpan().
+	 *
+	 * @param[in] logger target logger instance
+	 * @param nameId span name identifier
+	 */
+	LogSpan(const Logger& logger, uint32_t nameId) noexcept :
+		logger(logger.getInstance()), span(beginLogSpan(logger.getInstance(), nameId)) { }
+	/**
+	 * @brief Ends timing span. (MT-Safe)
+	 * @details See the @ref endLogSpan().
+	 */
+	~LogSpan() { endLogSpan(logger, span); }
+
+	LogSpan(const LogSpan&) = delete;
+	LogSpan& operator=(const LogSpan&) = delete;
 };
 
-} // namespace logy
\ No newline at end of file
+} // namespace logy
+
+#define LOGY_SPAN_CONCAT_IMPL(a, b) a##b
+#define LOGY_SPAN_CONCAT(a, b) LOGY_SPAN_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Measures timing span until the end of the current scope. (MT-Safe)
+ * @details Span name is registered once, at the first statement execution.
+ *
+ * @param logger logy::Logger instance
+ * @param name span name string literal
+ */
+#define LOGY_SPAN(logger, name)                                                                                \
+	static const uint32_t LOGY_SPAN_CONCAT(logySpanNameId, __LINE__) = registerLogSpanName(name);            \
+	logy::LogSpan LOGY_SPAN_CONCAT(logySpan, __LINE__)(logger, LOGY_SPAN_CONCAT(logySpanNameId, __LINE__))
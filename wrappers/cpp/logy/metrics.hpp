@@ -0,0 +1,88 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Log-derived metrics aggregation.
+ * @details See the @ref metrics.h
+ */
+
+#pragma once
+#include "logy/logger.hpp"
+
+extern "C"
+{
+#include "logy/metrics.h"
+}
+
+namespace logy
+{
+
+/**
+ * @brief Registered metric handle.
+ * @details Create it once (e.g. as a static variable), then record values with @ref record().
+ */
+class LogMetric final
+{
+	uint32_t id = 0;
+public:
+	/**
+	 * @brief Registers metric name in the global registry.
+	 * @details See the @ref registerLogMetric().
+	 *
+	 * @param[in] name metric name string
+	 * @throw Error if out of memory or metric count limit is reached.
+	 */
+	LogMetric(const string& name)
+	{
+		id = registerLogMetric(name.c_str());
+		if (id == 0)
+			throw Error(logyResultToString(FAILED_TO_ALLOCATE_LOGY_RESULT));
+	}
+
+	/**
+	 * @brief Returns metric identifier.
+	 */
+	uint32_t getId() const noexcept { return id; }
+	/**
+	 * @brief Returns metric name string.
+	 */
+	const char* getName() const noexcept { return getLogMetricName(id); }
+
+	/**
+	 * @brief Records metric value to the calling thread histogram. (MT-Safe, Lock-Free)
+	 * @details See the @ref logMetric().
+	 *
+	 * @param[in] logger logger instance
+	 * @param value metric value
+	 */
+	void record(const Logger& logger, double value) const noexcept
+	{
+		logMetric(logger.getInstance(), id, value);
+	}
+};
+
+/**
+ * @brief Returns total logger written message count of the specified level. (MT-Safe)
+ * @details See the @ref getLoggerMessageCount().
+ *
+ * @param[in] logger logger instance
+ * @param level message logging level
+ */
+static inline uint64_t getMessageCount(const Logger& logger, LogLevel level) noexcept
+{
+	return getLoggerMessageCount(logger.getInstance(), level);
+}
+
+} // namespace logy
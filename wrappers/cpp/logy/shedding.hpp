@@ -0,0 +1,60 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Adaptive load shedding.
+ * @details See the @ref shedding.h
+ */
+
+#pragma once
+#include "logy/logger.hpp"
+
+extern "C"
+{
+#include "logy/shedding.h"
+}
+
+namespace logy
+{
+
+/**
+ * @brief Returns true if logger currently sheds messages. (MT-Safe)
+ * @details See the @ref isLoggerShedding().
+ * @param[in] logger logger instance
+ */
+static inline bool isShedding(const Logger& logger) noexcept
+{
+	return isLoggerShedding(logger.getInstance());
+}
+/**
+ * @brief Returns logger effective logging level, limited by the load shedding. (MT-Safe)
+ * @details See the @ref getLoggerEffectiveLevel().
+ * @param[in] logger logger instance
+ */
+static inline LogLevel getEffectiveLevel(const Logger& logger) noexcept
+{
+	return getLoggerEffectiveLevel(logger.getInstance());
+}
+/**
+ * @brief Returns logger load shedding statistics. (MT-Safe)
+ * @details See the @ref getLoggerShedStats().
+ * @param[in] logger logger instance
+ */
+static inline LogShedStats getShedStats(const Logger& logger) noexcept
+{
+	return getLoggerShedStats(logger.getInstance());
+}
+
+} // namespace logy
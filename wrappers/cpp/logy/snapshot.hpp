@@ -0,0 +1,98 @@
+// Copyright 2021-2026 Nikita Fediuchin. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/***********************************************************************************************************************
+ * @file
+ * @brief Recent log records snapshot.
+ * @details See the @ref snapshot.h
+ */
+
+#pragma once
+#include "logy/logger.hpp"
+
+extern "C"
+{
+#include "logy/snapshot.h"
+}
+
+namespace logy
+{
+
+/**
+ * @brief Recent log records snapshot instance handle.
+ * @details See the @ref snapshot.h
+ */
+class LogSnapshot final
+{
+	LogSnapshot_T* instance = nullptr;
+public:
+	/**
+	 * @brief Creates a new empty log snapshot handle.
+	 */
+	LogSnapshot() = default;
+
+	LogSnapshot(const LogSnapshot&) = delete;
+	LogSnapshot(LogSnapshot&& r) noexcept : instance(std::exchange(r.instance, nullptr)) { }
+
+	LogSnapshot& operator=(LogSnapshot&) = delete;
+	LogSnapshot& operator=(LogSnapshot&& r) noexcept
+	{
+		instance = std::exchange(r.instance, nullptr);
+		return *this;
+	}
+
+	/*******************************************************************************************************************
+	 * @brief Creates a new snapshot of the recent logger records. (MT-Safe)
+	 * @details See the @ref createLogSnapshot().
+	 *
+	 * @param[in] logger target logger instance
+	 * @param[in] filter log record filter
+	 *
+	 * @throw Error with a @ref LogyResult string on failure.
+	 */
+	LogSnapshot(const Logger& logger, const LogFilter& filter = getDefaultLogFilter())
+	{
+		auto result = createLogSnapshot(logger.getInstance(), &filter, &instance);
+		if (result != SUCCESS_LOGY_RESULT)
+			throw Error(logyResultToString(result));
+	}
+
+	/**
+	 * @brief Destroys log record snapshot instance.
+	 * @details See the @ref destroyLogSnapshot().
+	 */
+	~LogSnapshot() { destroyLogSnapshot(instance); }
+
+	/*******************************************************************************************************************
+	 * @brief Returns log record snapshot entry count.
+	 * @details See the @ref getLogSnapshotSize().
+	 */
+	size_t getSize() const noexcept { return instance ? getLogSnapshotSize(instance) : 0; }
+
+	/**
+	 * @brief Returns log record snapshot entry.
+	 * @details See the @ref getLogSnapshotEntry().
+	 * @param index entry index
+	 */
+	LogEntry getEntry(size_t index) const noexcept { return getLogSnapshotEntry(instance, index); }
+
+	/**
+	 * @brief Returns log record snapshot entry.
+	 * @details See the @ref getLogSnapshotEntry().
+	 * @param index entry index
+	 */
+	LogEntry operator[](size_t index) const noexcept { return getLogSnapshotEntry(instance, index); }
+};
+
+} // namespace logy